@@ -1,12 +1,34 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <unordered_map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <algorithm>
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <numeric>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // MoveFileExA
+#endif
+
+#include "binary_input.hpp"
+#include "flat_hash_map.hpp"
+#include "mapped_file.hpp"
+#include "space_saving.hpp"
 
 using namespace std;
 
@@ -14,28 +36,65 @@ using namespace std;
     Napisz program zliczający ilosc wystapien danego slowa w pliku tekstowym. Wyswietl 20 najczęściej występujących slow (w kolejności malejącej).
 */
 
-std::vector<std::string> load_words(const std::string& file_name)
+// the same set of separators as operator>> in the "C" locale
+constexpr std::array<bool, 256> make_whitespace_table()
 {
-    ifstream fin(file_name);
+    std::array<bool, 256> table{};
 
-    if (!fin)
-        throw runtime_error("File "s + file_name + " can't be opened");
+    for (unsigned char c : { ' ', '\t', '\n', '\v', '\f', '\r' })
+        table[c] = true;
 
-    std::vector<std::string> words;
-    words.reserve(250'000);
+    return table;
+}
+
+constexpr std::array<bool, 256> whitespace_table = make_whitespace_table();
 
-    std::string token;
-    while (fin >> token)
+inline bool is_whitespace(char c)
+{
+    return whitespace_table[static_cast<unsigned char>(c)];
+}
+
+// calls f(token) for every whitespace-separated token in text
+template <typename F>
+void for_each_token(std::string_view text, F f)
+{
+    const char* it = text.data();
+    const char* const end = text.data() + text.size();
+
+    while (true)
     {
-        words.push_back(token);
+        while (it != end && is_whitespace(*it))
+            ++it;
+
+        if (it == end)
+            break;
+
+        const char* token_start = it;
+
+        while (it != end && !is_whitespace(*it))
+            ++it;
+
+        f(std::string_view(token_start, static_cast<size_t>(it - token_start)));
     }
+}
+
+std::vector<std::string_view> load_words(const MappedFile& file)
+{
+    std::vector<std::string_view> words;
+    words.reserve(250'000);
+
+    for_each_token(file.content(), [&words](std::string_view token) { words.push_back(token); });
 
     return words;
 }
 
-std::unordered_map<std::string, size_t> count_words(const std::vector<std::string>& words)
+// word -> number of occurrences
+using Concordance = FlatStringMap<size_t>;
+
+template <typename Map = Concordance>
+Map count_words(const std::vector<std::string_view>& words)
 {
-    std::unordered_map<std::string, size_t> concordance;
+    Map concordance;
 
     for (const auto& item : words)
         ++(concordance[item]);
@@ -43,27 +102,618 @@ std::unordered_map<std::string, size_t> count_words(const std::vector<std::strin
     return concordance;
 }
 
-std::multimap<size_t, std::string, std::greater<>> make_rating(const std::unordered_map<std::string, size_t>& concordance)
+// splits text into thread_count chunks whose boundaries never fall inside a token
+std::vector<std::string_view> split_into_chunks(std::string_view text, size_t thread_count)
+{
+    std::vector<std::string_view> chunks;
+    chunks.reserve(thread_count);
+
+    size_t chunk_start = 0;
+
+    for (size_t i = 1; i <= thread_count && chunk_start < text.size(); ++i)
+    {
+        size_t chunk_end = (i == thread_count) ? text.size() : std::max(chunk_start, text.size() / thread_count * i);
+
+        while (chunk_end < text.size() && !is_whitespace(text[chunk_end]))
+            ++chunk_end;
+
+        chunks.push_back(text.substr(chunk_start, chunk_end - chunk_start));
+        chunk_start = chunk_end;
+    }
+
+    return chunks;
+}
+
+// concordance split into shards by the hash of the word - result of the parallel count_words
+//  - words are views into the counted text, which must outlive the concordance
+//  - shards are selected by the high bits of the hash, the low bits index slots inside a shard
+class ShardedConcordance
+{
+public:
+    using Shard = FlatStringMap<size_t, ExternalKeys>;
+
+private:
+    std::vector<Shard> shards_;
+    int shard_bits_;
+
+public:
+    class const_iterator
+    {
+        const std::vector<Shard>* shards_;
+        size_t shard_;
+        Shard::const_iterator it_;
+
+        void skip_empty_shards()
+        {
+            while (shard_ + 1 < shards_->size() && it_ == (*shards_)[shard_].end())
+                it_ = (*shards_)[++shard_].begin();
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Shard::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator(const std::vector<Shard>& shards, size_t shard, Shard::const_iterator it)
+            : shards_(&shards), shard_(shard), it_(it)
+        {
+            skip_empty_shards();
+        }
+
+        reference operator*() const { return *it_; }
+        pointer operator->() const { return &*it_; }
+
+        const_iterator& operator++()
+        {
+            ++it_;
+            skip_empty_shards();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator prev = *this;
+            ++(*this);
+            return prev;
+        }
+
+        bool operator==(const const_iterator& other) const { return shard_ == other.shard_ && it_ == other.it_; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    explicit ShardedConcordance(int shard_bits = 0) : shards_(size_t{ 1 } << shard_bits), shard_bits_(shard_bits)
+    {
+    }
+
+    size_t shard_count() const
+    {
+        return shards_.size();
+    }
+
+    size_t shard_of(std::string_view word) const
+    {
+        if (shard_bits_ == 0)
+            return 0;
+
+        return std::hash<std::string_view>{}(word) >> (std::numeric_limits<size_t>::digits - shard_bits_);
+    }
+
+    Shard& shard(size_t index)
+    {
+        return shards_[index];
+    }
+
+    size_t size() const
+    {
+        return std::accumulate(shards_.begin(), shards_.end(), size_t{}, [](size_t total, const Shard& shard) { return total + shard.size(); });
+    }
+
+    const_iterator begin() const { return const_iterator(shards_, 0, shards_.front().begin()); }
+    const_iterator end() const { return const_iterator(shards_, shards_.size() - 1, shards_.back().end()); }
+
+    const_iterator find(std::string_view word) const
+    {
+        const size_t index = shard_of(word);
+        const auto it = shards_[index].find(word);
+
+        return it != shards_[index].end() ? const_iterator(shards_, index, it) : end();
+    }
+};
+
+// true if both maps hold the same words with the same counts
+template <typename Lhs, typename Rhs>
+bool have_same_counts(const Lhs& lhs, const Rhs& rhs)
+{
+    return lhs.size() == rhs.size() && std::all_of(lhs.begin(), lhs.end(), [&rhs](const auto& kv) {
+        auto it = rhs.find(kv.first);
+        return it != rhs.end() && it->second == kv.second;
+    });
+}
+
+// parallel version of count_words - gives the same counts as the serial one
+//  * phase 1: every worker counts its own chunk in one local map and partitions the counts into shards by hash
+//  * phase 2: workers take whole shards and merge them from all workers, so no map is shared between threads
+//    and there is no serial merge at the end
+//  - words are never copied: all maps keep views into text
+//  - the number of shards doesn't depend on thread_count, there are enough of them to balance the merge
+ShardedConcordance count_words(std::string_view text, size_t thread_count = std::thread::hardware_concurrency())
+{
+    constexpr int shard_bits = 6;
+
+    thread_count = std::max<size_t>(thread_count, 1);
+
+    const std::vector<std::string_view> chunks = split_into_chunks(text, thread_count);
+    const size_t worker_count = chunks.size();
+
+    if (worker_count <= 1)
+    {
+        ShardedConcordance concordance;
+        auto& counts = concordance.shard(0);
+        for_each_token(text, [&counts](std::string_view token) { ++(counts[token]); });
+        return concordance;
+    }
+
+    ShardedConcordance concordance(shard_bits);
+    const size_t shard_count = concordance.shard_count();
+
+    using WordCounts = std::vector<std::pair<std::string_view, size_t>>;
+    std::vector<std::vector<WordCounts>> partitions(worker_count, std::vector<WordCounts>(shard_count));
+
+    auto run_in_parallel = [](size_t task_count, auto task) {
+        std::vector<std::thread> threads;
+        threads.reserve(task_count);
+
+        for (size_t i = 0; i < task_count; ++i)
+            threads.emplace_back(task, i);
+
+        for (auto& thd : threads)
+            thd.join();
+    };
+
+    run_in_parallel(worker_count, [&](size_t worker) {
+        ShardedConcordance::Shard local_counts;
+        for_each_token(chunks[worker], [&local_counts](std::string_view token) { ++(local_counts[token]); });
+
+        auto& shards = partitions[worker];
+        for (const auto& item : local_counts)
+            shards[concordance.shard_of(item.first)].push_back(item);
+    });
+
+    std::atomic<size_t> next_shard{ 0 };
+
+    run_in_parallel(worker_count, [&](size_t) {
+        for (size_t shard = next_shard++; shard < shard_count; shard = next_shard++)
+        {
+            auto& target = concordance.shard(shard);
+            target.reserve(std::accumulate(partitions.begin(), partitions.end(), size_t{}, [shard](size_t total, const auto& shards) {
+                return total + shards[shard].size();
+            }));
+
+            for (auto& shards : partitions)
+            {
+                for (const auto& [word, counter] : shards[shard])
+                    target[word] += counter;
+
+                WordCounts{}.swap(shards[shard]);
+            }
+        }
+    });
+
+    return concordance;
+}
+
+// calls f(token) for every token read from the stream in blocks of block_size bytes
+//  - a token cut at the end of a block is carried over to the next one
+//  - memory used by the reader depends only on block_size (and the longest token), not on the length of the input
+template <typename F>
+void for_each_token(std::istream& in, F f, size_t block_size = 64 * 1024)
+{
+    std::vector<char> buffer(std::max<size_t>(block_size, 1));
+    size_t carry = 0;
+
+    while (true)
+    {
+        if (carry == buffer.size()) // token longer than the buffer
+            buffer.resize(buffer.size() * 2);
+
+        in.read(buffer.data() + carry, static_cast<std::streamsize>(buffer.size() - carry));
+        const size_t filled = carry + static_cast<size_t>(in.gcount());
+
+        if (filled == carry) // end of input
+        {
+            for_each_token(std::string_view(buffer.data(), carry), f);
+            break;
+        }
+
+        size_t last_separator = filled;
+        while (last_separator > 0 && !is_whitespace(buffer[last_separator - 1]))
+            --last_separator;
+
+        for_each_token(std::string_view(buffer.data(), last_separator), f);
+
+        carry = filled - last_separator;
+        std::copy(buffer.begin() + last_separator, buffer.begin() + filled, buffer.begin());
+    }
+}
+
+// streaming version of count_words - peak memory is proportional to the vocabulary only
+Concordance count_words(std::istream& in)
+{
+    Concordance concordance;
+
+    for_each_token(in, [&concordance](std::string_view token) { ++(concordance[token]); });
+
+    return concordance;
+}
+
+// binary snapshot of a concordance:
+//   magic "CONC", uint32 version, uint64 number of entries,
+//   then for every entry: uint32 length of the word, bytes of the word, uint64 counter
+// (integers are written in the native byte order - as in DataIO::write from streams/tests.cpp)
+namespace ConcordanceIO
+{
+    const char magic[4] = { 'C', 'O', 'N', 'C' };
+    const uint32_t version = 1;
+
+    template <typename T>
+    void write_value(ostream& out, T value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read_value(istream& in)
+    {
+        T value{};
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            throw runtime_error("Snapshot is truncated");
+        return value;
+    }
+
+    void write(ostream& out, const Concordance& concordance)
+    {
+        out.write(magic, sizeof(magic));
+        write_value<uint32_t>(out, version);
+        write_value<uint64_t>(out, concordance.size());
+
+        for (const auto& [word, counter] : concordance)
+        {
+            write_value<uint32_t>(out, static_cast<uint32_t>(word.size()));
+            out.write(word.data(), static_cast<std::streamsize>(word.size()));
+            write_value<uint64_t>(out, counter);
+        }
+    }
+
+    // reads length bytes - a corrupted length fails at the end of the stream instead of allocating gigabytes
+    void read_bytes(istream& in, std::string& bytes, size_t length)
+    {
+        bytes.clear();
+        BinaryInput::read_in_blocks(length, [&bytes](size_t size) { bytes.resize(size); }, [&](size_t offset, size_t count) {
+            if (!in.read(bytes.data() + offset, static_cast<std::streamsize>(count)))
+                throw runtime_error("Snapshot is truncated");
+        });
+    }
+
+    // adds counters from the snapshot to the concordance - reading into an empty concordance loads the snapshot
+    //  - sizes from the snapshot are checked against the bytes left in the stream before anything is allocated
+    void read(istream& in, Concordance& concordance)
+    {
+        char header[sizeof(magic)];
+        if (!in.read(header, sizeof(header)) || !std::equal(std::begin(header), std::end(header), std::begin(magic)))
+            throw runtime_error("Not a concordance snapshot");
+
+        if (read_value<uint32_t>(in) != version)
+            throw runtime_error("Unsupported snapshot version");
+
+        const uint64_t size = read_value<uint64_t>(in);
+        const std::streamoff remaining = BinaryInput::remaining_bytes(in);
+        const uint64_t min_entry_size = sizeof(uint32_t) + sizeof(uint64_t);
+
+        // bytes of entries not read yet - unlimited if the stream can't tell its size
+        uint64_t left = (remaining >= 0) ? static_cast<uint64_t>(remaining) : std::numeric_limits<uint64_t>::max();
+
+        if (size > left / min_entry_size)
+            throw runtime_error("Snapshot is truncated");
+
+        if (remaining >= 0)
+            concordance.reserve(concordance.size() + static_cast<size_t>(size));
+
+        std::string word;
+        for (uint64_t i = 0; i < size; ++i)
+        {
+            const uint32_t length = read_value<uint32_t>(in);
+
+            if (left < min_entry_size || left - min_entry_size < length)
+                throw runtime_error("Snapshot is truncated");
+            left -= min_entry_size + length;
+
+            read_bytes(in, word, length);
+
+            concordance[word] += static_cast<size_t>(read_value<uint64_t>(in));
+        }
+    }
+}
+
+void save_snapshot(const std::string& file_name, const Concordance& concordance)
+{
+    // write to a temporary file first, so a failed run never corrupts the existing snapshot
+    const std::string temp_file_name = file_name + ".tmp";
+
+    {
+        ofstream fout(temp_file_name, ios::out | ios::binary);
+
+        if (!fout)
+            throw runtime_error("File "s + temp_file_name + " can't be opened");
+
+        ConcordanceIO::write(fout, concordance);
+
+        if (!fout.flush())
+            throw runtime_error("Writing "s + temp_file_name + " failed");
+    }
+
+    // the old snapshot is replaced in one step - there is no moment when neither file exists
+#ifdef _WIN32
+    const bool replaced = MoveFileExA(temp_file_name.c_str(), file_name.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    const bool replaced = std::rename(temp_file_name.c_str(), file_name.c_str()) == 0; // atomic on POSIX, replaces an existing file
+#endif
+
+    if (!replaced)
+        throw runtime_error("File "s + temp_file_name + " can't be renamed to " + file_name);
+}
+
+void load_snapshot(const std::string& file_name, Concordance& concordance)
+{
+    ifstream fin(file_name, ios::in | ios::binary);
+
+    if (!fin)
+        throw runtime_error("File "s + file_name + " can't be opened");
+
+    ConcordanceIO::read(fin, concordance);
+}
+
+using RatingEntry = std::pair<std::string_view, size_t>;
+
+// higher count first; words with equal counts in alphabetical order
+inline bool is_ranked_higher(const RatingEntry& lhs, const RatingEntry& rhs)
+{
+    return lhs.second > rhs.second || (lhs.second == rhs.second && lhs.first < rhs.first);
+}
+
+// top_k most common words in descending order
+//  - bounded heap of top_k entries with the weakest entry on the top: O(U log K) time, one allocation
+template <typename Map>
+std::vector<RatingEntry> make_rating(const Map& concordance, size_t top_k)
 {
-    std::multimap<size_t, std::string, std::greater<>> rating;
+    std::vector<RatingEntry> rating;
+    rating.reserve(std::min(top_k, concordance.size()));
+
+    if (top_k == 0)
+        return rating;
 
     for (const auto& item : concordance)
-        rating.emplace(item.second, item.first);
+    {
+        if (rating.size() < top_k)
+        {
+            rating.emplace_back(item);
+            std::push_heap(rating.begin(), rating.end(), is_ranked_higher);
+        }
+        else if (is_ranked_higher(item, rating.front()))
+        {
+            std::pop_heap(rating.begin(), rating.end(), is_ranked_higher);
+            rating.back() = item;
+            std::push_heap(rating.begin(), rating.end(), is_ranked_higher);
+        }
+    }
+
+    std::sort_heap(rating.begin(), rating.end(), is_ranked_higher);
 
     return rating;
 }
 
-int main()
+void print_rating(const std::vector<RatingEntry>& rating)
+{
+    std::cout << "The most common words:\n";
+
+    for (const auto& [word, counter] : rating)
+        std::cout << word << " - " << counter << "\n";
+}
+
+// calls f(in) with the stream for a file or stdin ("-")
+template <typename F>
+void with_input_stream(const std::string& source, F f)
+{
+    if (source == "-")
+    {
+        std::ios::sync_with_stdio(false);
+        f(std::cin);
+        return;
+    }
+
+    ifstream fin(source, ios::in | ios::binary);
+
+    if (!fin)
+        throw runtime_error("File "s + source + " can't be opened");
+
+    f(fin);
+}
+
+// counts words from a file or stdin without loading the whole input
+void run_streaming(const std::string& source, size_t top_k)
+{
+    Concordance concordance;
+
+    with_input_stream(source, [&concordance](std::istream& in) { concordance = count_words(in); });
+
+    std::cout << "Streaming... " << concordance.size() << " distinct words has been counted...\n";
+
+    print_rating(make_rating(concordance, top_k));
+}
+
+// approximate top_k with a fixed number of counters - memory does not depend on the vocabulary
+void run_approximate(const std::string& source, size_t top_k, size_t capacity)
+{
+    SpaceSaving heavy_hitters(capacity);
+
+    with_input_stream(source, [&heavy_hitters](std::istream& in) {
+        for_each_token(in, [&heavy_hitters](std::string_view token) { heavy_hitters.add(token); });
+    });
+
+    std::cout << "Streaming... " << heavy_hitters.total() << " words has been counted with " << heavy_hitters.capacity() << " counters...\n";
+    std::cout << "The most common words (approximate, error <= " << heavy_hitters.error_bound() << "):\n";
+
+    for (const auto& entry : heavy_hitters.top(top_k))
+        std::cout << entry.word << " - " << entry.count << " (error <= " << entry.error << ")\n";
+}
+
+// adds words from a file or stdin to the snapshot (the snapshot is created if it does not exist)
+void run_snapshot_update(const std::string& snapshot, const std::string& source, size_t top_k)
+{
+    Concordance concordance;
+
+    if (ifstream(snapshot, ios::in | ios::binary))
+        load_snapshot(snapshot, concordance);
+
+    with_input_stream(source, [&concordance](std::istream& in) {
+        for_each_token(in, [&concordance](std::string_view token) { ++(concordance[token]); });
+    });
+
+    save_snapshot(snapshot, concordance);
+
+    std::cout << "Snapshot " << snapshot << " updated... " << concordance.size() << " distinct words...\n";
+
+    print_rating(make_rating(concordance, top_k));
+}
+
+// merges snapshots of several shards into one
+void run_snapshot_merge(const std::string& output, const std::vector<std::string>& snapshots, size_t top_k)
 {
-    const string file_name = "tokens.txt";
+    Concordance concordance;
 
-    std::vector<std::string> words = load_words(file_name);
+    for (const auto& snapshot : snapshots)
+        load_snapshot(snapshot, concordance);
+
+    save_snapshot(output, concordance);
+
+    std::cout << snapshots.size() << " snapshots merged into " << output << "... " << concordance.size() << " distinct words...\n";
+
+    print_rating(make_rating(concordance, top_k));
+}
+
+void run_benchmark(const std::string& file_name, size_t top_k)
+{
+    const MappedFile file(file_name);
+
+    std::vector<std::string_view> words = load_words(file);
 
     std::cout << "Loading file... " << words.size() << " words has been loaded...\n";
 
-    std::cout << "The most common words:\n";
+    auto start = std::chrono::high_resolution_clock::now();
+    auto std_concordance = count_words<std::unordered_map<std::string_view, size_t>>(words);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Serial counting time (std::unordered_map): " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    auto concordance = count_words(words);
+    end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Serial counting time (FlatStringMap): " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n";
+
+    if (!have_same_counts(std_concordance, concordance))
+        throw std::logic_error("FlatStringMap concordance differs from std::unordered_map one");
+
+    const size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+    start = std::chrono::high_resolution_clock::now();
+    auto parallel_concordance = count_words(file.content(), thread_count);
+    end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Parallel counting time (" << thread_count << " threads): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n";
+
+    if (!have_same_counts(parallel_concordance, concordance))
+        throw std::logic_error("Parallel concordance differs from the serial one");
+
+    const size_t capacity = std::max<size_t>(top_k * 50, 1'000);
+
+    start = std::chrono::high_resolution_clock::now();
+    SpaceSaving heavy_hitters(capacity);
+    for_each_token(file.content(), [&heavy_hitters](std::string_view token) { heavy_hitters.add(token); });
+    end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Approximate counting time (Space-Saving, " << capacity << " counters): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n";
+
+    const auto exact_rating = make_rating(concordance, top_k);
+    const auto approximate_rating = heavy_hitters.top(top_k);
+
+    size_t found = 0;
+    size_t max_error = 0;
+
+    for (const auto& entry : approximate_rating)
+    {
+        found += std::count_if(exact_rating.begin(), exact_rating.end(), [&entry](const RatingEntry& exact) { return exact.first == entry.word; });
+        max_error = std::max(max_error, entry.count - concordance.find(entry.word)->second);
+    }
+
+    std::cout << "Approximate top " << top_k << ": " << found << "/" << exact_rating.size() << " words found, max error: " << max_error
+              << " (guaranteed <= " << heavy_hitters.error_bound() << ")\n";
+
+    print_rating(make_rating(concordance, top_k));
+}
+
+void print_usage(std::ostream& out)
+{
+    out << "usage:\n"
+        << "  concordance [--stream | --approx] [file_name|-] [top_k] [counters]\n"
+        << "  concordance --update snapshot [file_name|-]\n"
+        << "  concordance --merge output snapshot...\n";
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    string mode;
+    if (!args.empty() && args.front().rfind("--", 0) == 0)
+    {
+        mode = args.front();
+        args.erase(args.begin());
+    }
+
+    const std::set<std::string> modes = { "--stream", "--approx", "--update", "--merge" };
+
+    if (!mode.empty() && modes.count(mode) == 0)
+    {
+        std::cerr << "Unknown mode " << mode << "\n";
+        print_usage(std::cerr);
+        return 1;
+    }
+
+    if (mode == "--update" || mode == "--merge")
+    {
+        if (args.empty())
+            throw runtime_error("Snapshot file name is missing");
+
+        if (mode == "--update")
+            run_snapshot_update(args[0], (args.size() > 1) ? args[1] : "-", 20);
+        else
+            run_snapshot_merge(args[0], std::vector<std::string>(args.begin() + 1, args.end()), 20);
+
+        return 0;
+    }
+
+    const string file_name = (args.size() > 0) ? args[0] : "tokens.txt";
+    const size_t top_k = (args.size() > 1) ? std::stoul(args[1]) : 20;
+    const size_t counters = (args.size() > 2) ? std::stoul(args[2]) : 1'000;
 
-    auto rating = make_rating(count_words(words));
-    
-    std::for_each_n(rating.begin(), 20, [](const auto& kv) { std::cout << kv.second << " - " << kv.first << "\n"; });
+    if (mode == "--stream")
+        run_streaming(file_name, top_k);
+    else if (mode == "--approx")
+        run_approximate(file_name, top_k, counters);
+    else
+        run_benchmark(file_name, top_k);
 }
@@ -0,0 +1,154 @@
+#ifndef SPACE_SAVING_HPP
+#define SPACE_SAVING_HPP
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// approximate top-k (heavy hitters) with the Space-Saving algorithm (Metwally, Agrawal, El Abbadi)
+//  - uses a fixed number of counters, independent of the number of distinct words
+//  - when all counters are taken, a new word replaces the word with the smallest counter
+//    and inherits its count (recorded as the error of the new entry)
+//  - guarantees: count - error <= true count <= count, and every word occurring
+//    more than total() / capacity() times is monitored
+class SpaceSaving
+{
+public:
+    struct Entry
+    {
+        std::string word;
+        size_t count;
+        size_t error; // max overestimation of count
+    };
+
+private:
+    size_t capacity_;
+    size_t total_ = 0;
+    std::vector<Entry> entries_; // reserved up front - views in index_ point into these strings
+    std::unordered_map<std::string_view, size_t> index_;
+    std::vector<size_t> heap_;     // min-heap of entry indexes ordered by count
+    std::vector<size_t> heap_pos_; // entry index -> position in heap_
+
+    bool less(size_t lhs_pos, size_t rhs_pos) const
+    {
+        return entries_[heap_[lhs_pos]].count < entries_[heap_[rhs_pos]].count;
+    }
+
+    void swap_nodes(size_t lhs_pos, size_t rhs_pos)
+    {
+        std::swap(heap_[lhs_pos], heap_[rhs_pos]);
+        heap_pos_[heap_[lhs_pos]] = lhs_pos;
+        heap_pos_[heap_[rhs_pos]] = rhs_pos;
+    }
+
+    void sift_down(size_t pos)
+    {
+        while (true)
+        {
+            size_t smallest = pos;
+            const size_t left = 2 * pos + 1;
+            const size_t right = left + 1;
+
+            if (left < heap_.size() && less(left, smallest))
+                smallest = left;
+            if (right < heap_.size() && less(right, smallest))
+                smallest = right;
+
+            if (smallest == pos)
+                return;
+
+            swap_nodes(pos, smallest);
+            pos = smallest;
+        }
+    }
+
+    void sift_up(size_t pos)
+    {
+        while (pos > 0 && less(pos, (pos - 1) / 2))
+        {
+            swap_nodes(pos, (pos - 1) / 2);
+            pos = (pos - 1) / 2;
+        }
+    }
+
+public:
+    explicit SpaceSaving(size_t capacity)
+        : capacity_(std::max<size_t>(capacity, 1))
+    {
+        entries_.reserve(capacity_);
+        index_.reserve(capacity_);
+        heap_.reserve(capacity_);
+        heap_pos_.reserve(capacity_);
+    }
+
+    SpaceSaving(const SpaceSaving&) = delete;
+    SpaceSaving& operator=(const SpaceSaving&) = delete;
+
+    void add(std::string_view word)
+    {
+        ++total_;
+
+        if (auto it = index_.find(word); it != index_.end())
+        {
+            ++entries_[it->second].count;
+            sift_down(heap_pos_[it->second]);
+        }
+        else if (entries_.size() < capacity_)
+        {
+            entries_.push_back(Entry{ std::string(word), 1, 0 });
+            const size_t index = entries_.size() - 1;
+            index_.emplace(entries_[index].word, index);
+            heap_.push_back(index);
+            heap_pos_.push_back(heap_.size() - 1);
+            sift_up(heap_.size() - 1);
+        }
+        else
+        {
+            const size_t index = heap_.front();
+            Entry& victim = entries_[index];
+
+            index_.erase(victim.word);
+            victim.word.assign(word.data(), word.size());
+            victim.error = victim.count;
+            ++victim.count;
+            index_.emplace(victim.word, index);
+
+            sift_down(0);
+        }
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    // number of words added so far
+    size_t total() const
+    {
+        return total_;
+    }
+
+    // upper bound of the error of every reported count (<= total() / capacity())
+    size_t error_bound() const
+    {
+        return entries_.size() < capacity_ ? 0 : entries_[heap_.front()].count;
+    }
+
+    // top_k monitored words ordered by estimated count
+    std::vector<Entry> top(size_t top_k) const
+    {
+        std::vector<Entry> result(entries_.begin(), entries_.end());
+
+        top_k = std::min(top_k, result.size());
+        std::partial_sort(result.begin(), result.begin() + top_k, result.end(), [](const Entry& lhs, const Entry& rhs) {
+            return lhs.count > rhs.count || (lhs.count == rhs.count && lhs.word < rhs.word);
+        });
+        result.resize(top_k);
+
+        return result;
+    }
+};
+
+#endif // SPACE_SAVING_HPP
@@ -0,0 +1,131 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "flat_hash_map.hpp"
+#include "../_ex-spellcheck/perfect_hash_dictionary.hpp"
+#include "catch.hpp"
+
+using namespace std;
+
+namespace
+{
+    std::vector<std::string> load_entries()
+    {
+        for (const char* file_name : { "en.dict", "../_ex-spellcheck/en.dict" })
+        {
+            ifstream in(file_name);
+
+            if (!in)
+                continue;
+
+            std::vector<std::string> entries;
+            std::string entry;
+
+            while (in >> entry)
+                entries.push_back(entry);
+
+            return entries;
+        }
+
+        throw runtime_error("File en.dict can't be opened");
+    }
+
+    // query_count words: hit_ratio of them are taken from the dictionary,
+    // the rest are dictionary words with one letter replaced, so they are not in the dictionary
+    std::vector<std::string> make_queries(const std::vector<std::string>& entries, const std::unordered_set<std::string>& dict, size_t query_count, double hit_ratio)
+    {
+        std::mt19937 rnd(665);
+        std::uniform_int_distribution<size_t> entry_index(0, entries.size() - 1);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::bernoulli_distribution is_hit(hit_ratio);
+
+        std::vector<std::string> queries;
+        queries.reserve(query_count);
+
+        while (queries.size() < query_count)
+        {
+            std::string word = entries[entry_index(rnd)];
+
+            if (!is_hit(rnd))
+            {
+                std::uniform_int_distribution<size_t> position(0, word.size() - 1);
+                word[position(rnd)] = static_cast<char>(letter(rnd));
+
+                if (dict.count(word))
+                    continue;
+            }
+
+            queries.push_back(std::move(word));
+        }
+
+        return queries;
+    }
+
+    template <typename IsCorrect>
+    size_t count_hits(const std::vector<std::string>& queries, IsCorrect is_correct)
+    {
+        return static_cast<size_t>(std::count_if(queries.begin(), queries.end(), is_correct));
+    }
+}
+
+TEST_CASE("dictionary lookups")
+{
+    const auto entries = load_entries();
+
+    const std::unordered_set<std::string> dict(entries.begin(), entries.end());
+
+    std::vector<std::string> vec_dict(entries.begin(), entries.end());
+    std::sort(vec_dict.begin(), vec_dict.end());
+
+    FlatStringSet flat_dict;
+    for (const auto& item : entries)
+        flat_dict.insert(item);
+
+    const PerfectHashDictionary perfect_hash_dict(entries);
+
+    auto in_unordered_set = [&](const std::string& word) { return dict.find(word) != dict.end(); };
+    auto in_sorted_vector = [&](const std::string& word) { return std::binary_search(vec_dict.begin(), vec_dict.end(), word); };
+    auto in_flat_set = [&](const std::string& word) { return flat_dict.contains(word); };
+    auto in_perfect_hash = [&](const std::string& word) { return perfect_hash_dict.contains(word); };
+
+    const size_t query_count = 100'000;
+
+    for (double hit_ratio : { 1.0, 0.9, 0.5 })
+    {
+        const auto queries = make_queries(entries, dict, query_count, hit_ratio);
+        const std::string variant = " - " + std::to_string(query_count) + " queries, " + std::to_string(static_cast<int>(hit_ratio * 100)) + "% hits";
+
+        // all engines must give the same answers
+        const size_t expected_hits = count_hits(queries, in_unordered_set);
+        REQUIRE(count_hits(queries, in_sorted_vector) == expected_hits);
+        REQUIRE(count_hits(queries, in_flat_set) == expected_hits);
+        REQUIRE(count_hits(queries, in_perfect_hash) == expected_hits);
+
+        BENCHMARK("std::unordered_set" + variant)
+        {
+            return count_hits(queries, in_unordered_set);
+        };
+
+        BENCHMARK("sorted std::vector" + variant)
+        {
+            return count_hits(queries, in_sorted_vector);
+        };
+
+        BENCHMARK("FlatStringSet" + variant)
+        {
+            return count_hits(queries, in_flat_set);
+        };
+
+        BENCHMARK("PerfectHashDictionary" + variant)
+        {
+            return count_hits(queries, in_perfect_hash);
+        };
+    }
+}
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flat_hash_map.hpp"
+#include "catch.hpp"
+
+using namespace std;
+
+namespace
+{
+    std::vector<std::string> make_keys(size_t count)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+            keys.push_back("key" + std::to_string(i));
+
+        return keys;
+    }
+
+    // count keys whose hashes all fall into the last slot of a table with slot_count slots -
+    // they collide and their probes wrap around to the beginning of the table
+    std::vector<std::string> make_keys_for_last_slot(size_t count, size_t slot_count)
+    {
+        std::vector<std::string> keys;
+
+        for (size_t i = 0; keys.size() < count; ++i)
+        {
+            std::string key = "key" + std::to_string(i);
+
+            if ((std::hash<std::string_view>{}(key) & (slot_count - 1)) == slot_count - 1)
+                keys.push_back(std::move(key));
+        }
+
+        return keys;
+    }
+
+    bool is_inside(std::string_view str, const std::string& buffer)
+    {
+        return str.data() >= buffer.data() && str.data() + str.size() <= buffer.data() + buffer.size();
+    }
+}
+
+TEST_CASE("FlatStringMap - colliding keys wrap around the end of the table")
+{
+    // 16 slots - the table doesn't grow below 12 keys (max load factor 3/4)
+    const auto keys = make_keys_for_last_slot(11, 16);
+    const auto missing = make_keys_for_last_slot(12, 16).back();
+
+    FlatStringMap<size_t> map;
+    for (size_t i = 0; i < keys.size(); ++i)
+        map[keys[i]] = i;
+
+    REQUIRE(map.size() == keys.size());
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        REQUIRE(map.count(keys[i]) == 1);
+        REQUIRE(map.find(keys[i])->second == i);
+    }
+
+    REQUIRE(map.find(missing) == map.end());
+    REQUIRE(std::distance(map.begin(), map.end()) == static_cast<std::ptrdiff_t>(keys.size()));
+
+    FlatStringSet set;
+    for (const auto& key : keys)
+        REQUIRE(set.insert(key).second);
+
+    REQUIRE(!set.insert(keys.front()).second);
+    REQUIRE(set.size() == keys.size());
+    REQUIRE(!set.contains(missing));
+}
+
+TEST_CASE("FlatStringMap - growth")
+{
+    const auto keys = make_keys(10'000);
+
+    SECTION("every key survives the rehashes and is visited once")
+    {
+        FlatStringMap<size_t> map;
+        for (size_t i = 0; i < keys.size(); ++i)
+            map[keys[i]] = i;
+
+        REQUIRE(map.size() == keys.size());
+
+        std::set<std::string_view> visited;
+        for (const auto& [key, value] : map)
+        {
+            REQUIRE(keys[value] == key);
+            REQUIRE(visited.insert(key).second);
+        }
+
+        REQUIRE(visited.size() == keys.size());
+    }
+
+    SECTION("a map grows while another one is iterated")
+    {
+        FlatStringMap<size_t> source;
+        for (size_t i = 0; i < keys.size(); ++i)
+            source[keys[i]] = i;
+
+        FlatStringMap<size_t> target;
+        for (const auto& kv : source)
+            target.insert(kv);
+
+        REQUIRE(target == source);
+    }
+
+    SECTION("reserve() prevents rehashing")
+    {
+        FlatStringMap<size_t> map;
+        map.reserve(keys.size());
+
+        map[keys.front()] = 42;
+        const size_t* first_value = &map[keys.front()];
+
+        for (size_t i = 1; i < keys.size(); ++i)
+            map[keys[i]] = i;
+
+        REQUIRE(&map[keys.front()] == first_value);
+        REQUIRE(*first_value == 42);
+    }
+}
+
+TEST_CASE("FlatStringMap - copies own their keys")
+{
+    std::string buffer = "alpha beta gamma";
+    const std::string_view text = buffer;
+
+    FlatStringMap<int> map;
+    map[text.substr(0, 5)] = 1;
+    map[text.substr(6, 4)] = 2;
+
+    SECTION("inserted keys are copied")
+    {
+        for (const auto& kv : map)
+            REQUIRE(!is_inside(kv.first, buffer));
+
+        buffer.assign(buffer.size(), 'x');
+        REQUIRE(map.find("alpha")->second == 1);
+    }
+
+    SECTION("copy constructor")
+    {
+        FlatStringMap<int> copy(map);
+        map.clear();
+        map["delta"] = 3;
+
+        REQUIRE(copy.size() == 2);
+        REQUIRE(copy.find("alpha")->second == 1);
+        REQUIRE(copy.find("beta")->second == 2);
+        REQUIRE(copy.count("delta") == 0);
+    }
+
+    SECTION("copy assignment")
+    {
+        FlatStringMap<int> copy;
+        copy["omega"] = 9;
+        copy = map;
+
+        {
+            const FlatStringMap<int> temp(std::move(map));
+        }
+
+        REQUIRE(copy.size() == 2);
+        REQUIRE(copy.count("omega") == 0);
+        REQUIRE(copy.find("alpha")->second == 1);
+        REQUIRE(copy.find("beta")->second == 2);
+    }
+}
+
+TEST_CASE("FlatStringMap - ExternalKeys")
+{
+    const std::string buffer = "alpha beta gamma beta";
+    const std::string_view text = buffer;
+
+    FlatStringMap<int, ExternalKeys> views;
+    ++views[text.substr(0, 5)];
+    ++views[text.substr(6, 4)];
+    ++views[text.substr(11, 5)];
+    ++views[text.substr(17, 4)];
+
+    SECTION("keys are not copied")
+    {
+        REQUIRE(views.size() == 3);
+
+        for (const auto& kv : views)
+            REQUIRE(is_inside(kv.first, buffer));
+
+        REQUIRE(views.find("beta")->first.data() == buffer.data() + 6);
+        REQUIRE(views.find("beta")->second == 2);
+    }
+
+    SECTION("comparison with a map owning its keys")
+    {
+        FlatStringMap<int> owned;
+        owned["alpha"] = 1;
+        owned["beta"] = 2;
+        owned["gamma"] = 1;
+
+        REQUIRE(views == owned);
+        REQUIRE(owned == views);
+
+        owned["gamma"] = 5;
+        REQUIRE(views != owned);
+
+        owned.clear();
+        owned["alpha"] = 1;
+        owned["beta"] = 2;
+        REQUIRE(views != owned);
+
+        owned["delta"] = 1;
+        REQUIRE(views != owned);
+        REQUIRE(owned != views);
+    }
+}
+
+TEST_CASE("moved-from flat tables are empty and can be reused")
+{
+    SECTION("FlatStringMap")
+    {
+        FlatStringMap<int> a;
+        a["one"] = 1;
+
+        FlatStringMap<int> b(std::move(a));
+
+        REQUIRE(a.size() == 0);
+        REQUIRE(a.find("one") == a.end());
+
+        a["ZZZZZ"] = 2;
+        REQUIRE(a.size() == 1);
+        REQUIRE(a.find("ZZZZZ")->second == 2);
+
+        b = std::move(a);
+        REQUIRE(a.empty());
+        REQUIRE(b.size() == 1);
+        REQUIRE(b.count("one") == 0);
+
+        a["one"] = 3;
+        REQUIRE(a.find("one")->second == 3);
+        REQUIRE(b.find("ZZZZZ")->second == 2);
+    }
+
+    SECTION("FlatStringSet")
+    {
+        FlatStringSet a;
+        a.insert("one");
+
+        const FlatStringSet b(std::move(a));
+
+        REQUIRE(a.empty());
+        REQUIRE(!a.contains("one"));
+
+        a.insert("two");
+        REQUIRE(a.contains("two"));
+        REQUIRE(b.contains("one"));
+        REQUIRE(!b.contains("two"));
+    }
+}
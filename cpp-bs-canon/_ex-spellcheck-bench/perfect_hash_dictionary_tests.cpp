@@ -0,0 +1,116 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../_ex-spellcheck/perfect_hash_dictionary.hpp"
+#include "catch.hpp"
+
+using namespace std;
+
+namespace
+{
+    // file with the given content, removed when the object is destroyed
+    class TempFile
+    {
+        std::string file_name_;
+
+    public:
+        TempFile(std::string file_name, const std::string& content) : file_name_(std::move(file_name))
+        {
+            ofstream out(file_name_, ios::out | ios::binary);
+            out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        }
+
+        TempFile(const TempFile&) = delete;
+        TempFile& operator=(const TempFile&) = delete;
+
+        ~TempFile()
+        {
+            std::remove(file_name_.c_str());
+        }
+
+        const std::string& file_name() const
+        {
+            return file_name_;
+        }
+    };
+
+    std::string image_of(const PerfectHashDictionary& dict)
+    {
+        ostringstream out;
+        dict.save(out);
+        return out.str();
+    }
+}
+
+TEST_CASE("PerfectHashDictionary image")
+{
+    const std::vector<std::string> words = { "apple", "banana", "cherry", "date", "elderberry", "fig", "grape" };
+    const PerfectHashDictionary dict(words);
+    const std::string image = image_of(dict);
+
+    PerfectHashDictionary::ImageHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+
+    SECTION("loaded image finds the same words")
+    {
+        const TempFile file("phd_test.image", image);
+        const auto loaded = PerfectHashDictionary::load(file.file_name());
+
+        REQUIRE(loaded.size() == words.size());
+        for (const auto& word : words)
+            REQUIRE(loaded.contains(word));
+        REQUIRE(!loaded.contains("apricot"));
+    }
+
+    SECTION("truncated image")
+    {
+        for (size_t size : { size_t{ 10 }, sizeof(header), sizeof(header) + 4, image.size() - 1 })
+        {
+            const TempFile file("phd_test.image", image.substr(0, size));
+            REQUIRE_THROWS_AS(PerfectHashDictionary::load(file.file_name()), std::runtime_error);
+        }
+    }
+
+    SECTION("counts in the header don't fit the image")
+    {
+        for (uint64_t count : { uint64_t{ 1 } << 62, ~uint64_t{ 0 }, uint64_t{ 1'000 } })
+        {
+            std::string corrupted = image;
+
+            PerfectHashDictionary::ImageHeader bad_header = header;
+            bad_header.word_count = count;
+            std::memcpy(corrupted.data(), &bad_header, sizeof(bad_header));
+
+            const TempFile words_file("phd_test.image", corrupted);
+            REQUIRE_THROWS_AS(PerfectHashDictionary::load(words_file.file_name()), std::runtime_error);
+
+            bad_header = header;
+            bad_header.bucket_count = count;
+            std::memcpy(corrupted.data(), &bad_header, sizeof(bad_header));
+
+            const TempFile buckets_file("phd_test_buckets.image", corrupted);
+            REQUIRE_THROWS_AS(PerfectHashDictionary::load(buckets_file.file_name()), std::runtime_error);
+        }
+    }
+
+    SECTION("slot pointing outside the string pool")
+    {
+        const size_t slots_offset = sizeof(header) + (header.bucket_count * sizeof(uint32_t) + 7) / 8 * 8;
+
+        for (PerfectHashDictionary::Slot bad_slot : { PerfectHashDictionary::Slot{ 0xFFFF'FFF0u, 4 },
+                 PerfectHashDictionary::Slot{ 0, static_cast<uint32_t>(header.pool_size + 1) } })
+        {
+            std::string corrupted = image;
+            std::memcpy(corrupted.data() + slots_offset + 3 * sizeof(bad_slot), &bad_slot, sizeof(bad_slot));
+
+            const TempFile file("phd_test.image", corrupted);
+            REQUIRE_THROWS_AS(PerfectHashDictionary::load(file.file_name()), std::runtime_error);
+        }
+    }
+}
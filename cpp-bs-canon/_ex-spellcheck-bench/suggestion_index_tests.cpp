@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../_ex-spellcheck/suggestion_index.hpp"
+#include "catch.hpp"
+
+using namespace std;
+
+namespace
+{
+    // stream buffer that can't seek, like a pipe
+    class UnseekableBuffer : public std::stringbuf
+    {
+    public:
+        explicit UnseekableBuffer(const std::string& content) : std::stringbuf(content, ios::in)
+        {
+        }
+
+    protected:
+        pos_type seekoff(off_type, ios::seekdir, ios::openmode) override
+        {
+            return pos_type(off_type(-1));
+        }
+
+        pos_type seekpos(pos_type, ios::openmode) override
+        {
+            return pos_type(off_type(-1));
+        }
+    };
+
+    std::string image_of(const SuggestionIndex& index)
+    {
+        ostringstream out;
+        index.save(out);
+        return out.str();
+    }
+
+    SuggestionIndex load(const std::string& image)
+    {
+        istringstream in(image);
+        return SuggestionIndex::load(in);
+    }
+
+    // position of the size of array number array_index in the image (0 - pool, 1 - word offsets,
+    // 2 - delete hashes, 3 - delete offsets, 4 - word ids)
+    size_t array_position(const std::string& image, size_t array_index)
+    {
+        const size_t element_sizes[] = { 1, sizeof(uint32_t), sizeof(uint64_t), sizeof(uint32_t), sizeof(uint32_t) };
+        size_t position = 4 + 3 * sizeof(uint32_t);
+
+        for (size_t i = 0; i < array_index; ++i)
+        {
+            uint64_t size;
+            std::memcpy(&size, image.data() + position, sizeof(size));
+            position += sizeof(size) + static_cast<size_t>(size) * element_sizes[i];
+        }
+
+        return position;
+    }
+
+    template <typename T>
+    void overwrite(std::string& image, size_t position, T value)
+    {
+        std::memcpy(image.data() + position, &value, sizeof(value));
+    }
+}
+
+TEST_CASE("SuggestionIndex image")
+{
+    const SuggestionIndex index(std::vector<std::string>{ "apple", "apply", "ample", "maple", "banana", "bandana", "cherry" });
+    const std::string image = image_of(index);
+
+    SECTION("loaded index gives the same suggestions and uses the same memory")
+    {
+        const SuggestionIndex loaded = load(image);
+
+        REQUIRE(loaded.size() == index.size());
+        REQUIRE(loaded.memory_usage() == index.memory_usage());
+
+        for (const char* query : { "appel", "banan", "chery", "xyz" })
+        {
+            const auto expected = index.suggest(query);
+            const auto actual = loaded.suggest(query);
+
+            REQUIRE(actual.size() == expected.size());
+            for (size_t i = 0; i < actual.size(); ++i)
+            {
+                REQUIRE(actual[i].word == expected[i].word);
+                REQUIRE(actual[i].distance == expected[i].distance);
+            }
+        }
+    }
+
+    SECTION("empty index")
+    {
+        REQUIRE(load(image_of(SuggestionIndex())).size() == 0);
+        REQUIRE(load(image_of(SuggestionIndex(std::vector<std::string>{}))).suggest("apple").empty());
+    }
+
+    SECTION("truncated image")
+    {
+        for (size_t size = 0; size < image.size(); size += 7)
+            REQUIRE_THROWS_AS(load(image.substr(0, size)), std::runtime_error);
+    }
+
+    SECTION("corrupted array size throws instead of allocating")
+    {
+        for (size_t array_index = 0; array_index < 5; ++array_index)
+        {
+            std::string corrupted = image;
+            overwrite<uint64_t>(corrupted, array_position(image, array_index), uint64_t{ 1 } << 40);
+
+            REQUIRE_THROWS_WITH(load(corrupted), "Suggestion index image is truncated");
+
+            UnseekableBuffer buffer(corrupted);
+            std::istream in(&buffer);
+            REQUIRE_THROWS_WITH(SuggestionIndex::load(in), "Suggestion index image is truncated");
+        }
+    }
+
+    SECTION("inconsistent arrays")
+    {
+        const size_t word_offsets = array_position(image, 1) + sizeof(uint64_t);
+        const size_t delete_offsets = array_position(image, 3) + sizeof(uint64_t);
+        const size_t word_ids = array_position(image, 4) + sizeof(uint64_t);
+
+        std::string corrupted = image;
+        overwrite<uint32_t>(corrupted, word_offsets + 2 * sizeof(uint32_t), 1'000'000);
+        REQUIRE_THROWS_WITH(load(corrupted), "Suggestion index image is corrupted");
+
+        corrupted = image;
+        overwrite<uint32_t>(corrupted, word_offsets, 1);
+        REQUIRE_THROWS_WITH(load(corrupted), "Suggestion index image is corrupted");
+
+        corrupted = image;
+        overwrite<uint32_t>(corrupted, delete_offsets + sizeof(uint32_t), 1'000'000);
+        REQUIRE_THROWS_WITH(load(corrupted), "Suggestion index image is corrupted");
+
+        corrupted = image;
+        overwrite<uint32_t>(corrupted, word_ids, static_cast<uint32_t>(index.size()));
+        REQUIRE_THROWS_WITH(load(corrupted), "Suggestion index image is corrupted");
+    }
+}
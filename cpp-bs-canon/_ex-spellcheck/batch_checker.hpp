@@ -0,0 +1,76 @@
+#ifndef BATCH_CHECKER_HPP
+#define BATCH_CHECKER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "text_splitter.hpp"
+
+struct Misspelling
+{
+    size_t offset; // position of the word in the document
+    std::string_view word;
+};
+
+struct DocumentReport
+{
+    size_t word_count = 0;
+    std::vector<Misspelling> misspellings;
+};
+
+// calls task(index) for every index in [0, count) on thread_count worker threads
+//  - workers take the next index from a shared atomic counter, so long and short tasks are balanced
+template <typename Task>
+void parallel_for(size_t count, size_t thread_count, Task task)
+{
+    thread_count = std::clamp<size_t>(thread_count, 1, std::max<size_t>(count, 1));
+
+    std::atomic<size_t> next_index{ 0 };
+
+    auto worker = [&] {
+        for (size_t index = next_index++; index < count; index = next_index++)
+            task(index);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+
+    for (size_t i = 1; i < thread_count; ++i)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (auto& thd : threads)
+        thd.join();
+}
+
+// checks every document against one shared, read-only dictionary
+//  - Dictionary must provide bool contains(std::string_view) const that is safe to call concurrently
+//  - reports keep string_views into documents
+template <typename Dictionary>
+std::vector<DocumentReport> check_documents(const std::vector<std::string>& documents, const Dictionary& dict,
+    size_t thread_count = std::thread::hardware_concurrency())
+{
+    std::vector<DocumentReport> reports(documents.size());
+
+    parallel_for(documents.size(), thread_count, [&](size_t index) {
+        const std::string& document = documents[index];
+        DocumentReport& report = reports[index];
+
+        for (std::string_view word : split(document))
+        {
+            ++report.word_count;
+
+            if (!dict.contains(word))
+                report.misspellings.push_back(Misspelling{ static_cast<size_t>(word.data() - document.data()), word });
+        }
+    });
+
+    return reports;
+}
+
+#endif // BATCH_CHECKER_HPP
@@ -0,0 +1,295 @@
+#ifndef PERFECT_HASH_DICTIONARY_HPP
+#define PERFECT_HASH_DICTIONARY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.hpp"
+
+// static dictionary with a minimal perfect hash function (hash & displace, CHD-like)
+//  - build step: words are split into buckets by their hash; for every bucket (the largest first)
+//    a seed is searched that moves all its words into free slots - every word gets its own slot
+//    and the table has exactly one slot per word
+//  - lookup: one hash of the word, seeds[bucket] -> slot -> compare with the word in the string pool
+//    (no allocation, the seed table is small enough to stay in cache)
+//  - all data is kept in one relocatable image (offsets only, no pointers):
+//      ImageHeader | seeds (uint32 per bucket, padded to 8 bytes) | slots (Slot per word) | string pool
+//    built in memory by the constructor, written with save() and mapped directly from a file with load()
+class PerfectHashDictionary
+{
+public:
+    struct Slot
+    {
+        uint32_t offset; // position of the word in the string pool
+        uint32_t length;
+    };
+
+    struct ImageHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t word_count;
+        uint64_t bucket_count;
+        uint64_t pool_size;
+    };
+
+    static constexpr size_t words_per_bucket = 4;
+    static constexpr uint32_t max_seed = 1'000'000;
+    static constexpr uint32_t image_version = 1;
+
+private:
+    std::vector<char> buffer_;                 // image built in memory
+    std::shared_ptr<const MappedFile> mapping_; // or image mapped from a file
+    size_t word_count_ = 0;
+    size_t bucket_count_ = 0;
+    size_t slots_offset_ = 0;
+    size_t pool_offset_ = 0;
+    size_t pool_size_ = 0;
+
+    static size_t seeds_offset()
+    {
+        return sizeof(ImageHeader);
+    }
+
+    static size_t slots_offset(size_t bucket_count)
+    {
+        return seeds_offset() + (bucket_count * sizeof(uint32_t) + 7) / 8 * 8;
+    }
+
+    const char* image() const
+    {
+        return mapping_ ? mapping_->content().data() : buffer_.data();
+    }
+
+    size_t image_size() const
+    {
+        return mapping_ ? mapping_->content().size() : buffer_.size();
+    }
+
+    const uint32_t* seeds() const
+    {
+        return reinterpret_cast<const uint32_t*>(image() + seeds_offset());
+    }
+
+    const Slot* slots() const
+    {
+        return reinterpret_cast<const Slot*>(image() + slots_offset_);
+    }
+
+    const char* pool() const
+    {
+        return image() + pool_offset_;
+    }
+
+    // reads the layout from the header of the image
+    //  - sizes from the header are checked against the size of the image without overflowing,
+    //    so every table lies inside the image
+    void attach()
+    {
+        const size_t size = image_size();
+
+        if (size < sizeof(ImageHeader))
+            throw std::runtime_error("Dictionary image is truncated");
+
+        ImageHeader header;
+        std::memcpy(&header, image(), sizeof(header));
+
+        if (std::memcmp(header.magic, "PHDI", 4) != 0)
+            throw std::runtime_error("Not a dictionary image");
+
+        if (header.version != image_version)
+            throw std::runtime_error("Unsupported dictionary image version");
+
+        if ((header.word_count == 0) != (header.bucket_count == 0))
+            throw std::runtime_error("Dictionary image is corrupted");
+
+        if (header.bucket_count > (size - seeds_offset()) / sizeof(uint32_t))
+            throw std::runtime_error("Dictionary image is truncated");
+
+        bucket_count_ = static_cast<size_t>(header.bucket_count);
+        slots_offset_ = slots_offset(bucket_count_);
+
+        if (slots_offset_ > size || header.word_count > (size - slots_offset_) / sizeof(Slot))
+            throw std::runtime_error("Dictionary image is truncated");
+
+        word_count_ = static_cast<size_t>(header.word_count);
+        pool_offset_ = slots_offset_ + word_count_ * sizeof(Slot);
+
+        if (header.pool_size > size - pool_offset_)
+            throw std::runtime_error("Dictionary image is truncated");
+
+        pool_size_ = static_cast<size_t>(header.pool_size);
+    }
+
+    // every slot must refer to a word inside the string pool
+    void check_slots() const
+    {
+        const Slot* slot = slots();
+
+        for (size_t i = 0; i < word_count_; ++i)
+        {
+            if (slot[i].offset > pool_size_ || slot[i].length > pool_size_ - slot[i].offset)
+                throw std::runtime_error("Dictionary image is corrupted");
+        }
+    }
+
+public:
+    // FNV-1a
+    static uint64_t hash(std::string_view word)
+    {
+        uint64_t h = 14695981039346656037ull;
+
+        for (unsigned char c : word)
+        {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+
+        return h;
+    }
+
+    // final mix of MurmurHash3 - spreads the word hash differently for every seed
+    static uint64_t mix(uint64_t h, uint32_t seed)
+    {
+        h ^= (seed + 1) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+
+        return h;
+    }
+
+    PerfectHashDictionary() = default;
+
+    explicit PerfectHashDictionary(std::vector<std::string> words)
+    {
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+
+        const size_t word_count = words.size();
+        const size_t bucket_count = (word_count + words_per_bucket - 1) / words_per_bucket;
+
+        std::vector<uint64_t> hashes(word_count);
+        std::vector<std::vector<uint32_t>> buckets(bucket_count);
+
+        for (uint32_t i = 0; i < word_count; ++i)
+        {
+            hashes[i] = hash(words[i]);
+            buckets[hashes[i] % bucket_count].push_back(i);
+        }
+
+        std::vector<uint32_t> bucket_order(bucket_count);
+        std::iota(bucket_order.begin(), bucket_order.end(), 0);
+        std::stable_sort(bucket_order.begin(), bucket_order.end(), [&buckets](uint32_t lhs, uint32_t rhs) {
+            return buckets[lhs].size() > buckets[rhs].size();
+        });
+
+        constexpr uint32_t empty_slot = UINT32_MAX;
+        std::vector<uint32_t> word_in_slot(word_count, empty_slot);
+        std::vector<uint32_t> seeds(bucket_count, 0);
+        std::vector<size_t> candidate_slots;
+
+        for (uint32_t bucket : bucket_order)
+        {
+            const auto& members = buckets[bucket];
+
+            if (members.empty())
+                break;
+
+            uint32_t seed = 0;
+            for (; seed < max_seed; ++seed)
+            {
+                candidate_slots.clear();
+
+                for (uint32_t word : members)
+                {
+                    const size_t slot = mix(hashes[word], seed) % word_count;
+
+                    if (word_in_slot[slot] != empty_slot || std::find(candidate_slots.begin(), candidate_slots.end(), slot) != candidate_slots.end())
+                        break;
+
+                    candidate_slots.push_back(slot);
+                }
+
+                if (candidate_slots.size() == members.size())
+                    break;
+            }
+
+            if (seed == max_seed)
+                throw std::runtime_error("Perfect hash function can't be built");
+
+            seeds[bucket] = seed;
+            for (size_t i = 0; i < members.size(); ++i)
+                word_in_slot[candidate_slots[i]] = members[i];
+        }
+
+        const size_t pool_size = std::accumulate(words.begin(), words.end(), size_t{}, [](size_t total, const std::string& w) { return total + w.size(); });
+
+        ImageHeader header{ { 'P', 'H', 'D', 'I' }, image_version, word_count, bucket_count, pool_size };
+
+        buffer_.resize(slots_offset(bucket_count) + word_count * sizeof(Slot) + pool_size);
+        std::memcpy(buffer_.data(), &header, sizeof(header));
+        if (bucket_count > 0)
+            std::memcpy(buffer_.data() + seeds_offset(), seeds.data(), bucket_count * sizeof(uint32_t));
+
+        attach();
+
+        Slot* slot = reinterpret_cast<Slot*>(buffer_.data() + slots_offset_);
+        char* pool = buffer_.data() + pool_offset_;
+        uint32_t offset = 0;
+
+        for (size_t i = 0; i < word_count; ++i)
+        {
+            const std::string& word = words[word_in_slot[i]];
+            slot[i] = Slot{ offset, static_cast<uint32_t>(word.size()) };
+            std::memcpy(pool + offset, word.data(), word.size());
+            offset += static_cast<uint32_t>(word.size());
+        }
+    }
+
+    // maps the image written by save() - lookups read directly from the mapping, nothing is copied
+    //  - the layout and every slot are checked once, so a damaged file throws std::runtime_error instead of
+    //    sending lookups outside the mapping
+    static PerfectHashDictionary load(const std::string& image_file_name)
+    {
+        PerfectHashDictionary dict;
+        dict.mapping_ = std::make_shared<const MappedFile>(image_file_name);
+        dict.attach();
+        dict.check_slots();
+
+        return dict;
+    }
+
+    void save(std::ostream& out) const
+    {
+        out.write(image(), static_cast<std::streamsize>(image_size()));
+    }
+
+    size_t size() const
+    {
+        return word_count_;
+    }
+
+    bool contains(std::string_view word) const
+    {
+        if (word_count_ == 0)
+            return false;
+
+        const uint64_t h = hash(word);
+        const Slot& slot = slots()[mix(h, seeds()[h % bucket_count_]) % word_count_];
+
+        return std::string_view(pool() + slot.offset, slot.length) == word;
+    }
+};
+
+#endif // PERFECT_HASH_DICTIONARY_HPP
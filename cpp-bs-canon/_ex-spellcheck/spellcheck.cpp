@@ -1,89 +1,306 @@
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <set>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
-#include <regex>
 #include <unordered_set>
 
+#include "flat_hash_map.hpp"
+#include "batch_checker.hpp"
+#include "perfect_hash_dictionary.hpp"
+#include "suggestion_index.hpp"
+#include "text_splitter.hpp"
+
 using namespace std;
 
-vector<std::string> regex_split(const std::string& s, std::string regex_str = R"(\s+)")
+// builds a dictionary and reports the time of the build
+template <typename Builder>
+auto build_dictionary(const std::string& engine, Builder build)
 {
-    std::vector<std::string> words;
+    auto start = std::chrono::high_resolution_clock::now();
 
-    std::regex rgx(regex_str);
+    auto dict = build();
 
-    std::sregex_token_iterator iter(s.begin(), s.end(), rgx, -1);
-    std::sregex_token_iterator end;
+    auto end = std::chrono::high_resolution_clock::now();
 
-    while (iter != end)
-    {
-        words.push_back(*iter);
-        ++iter;
-    }
+    std::cout << "Build time (" << engine << "): " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n";
 
-    return words;
+    return dict;
 }
 
-int main()
+// reports misspelled words and the time of the lookups
+//  - Word is the type of queries accepted by the engine without conversions (std::string_view or std::string)
+template <typename Word, typename IsCorrect>
+void check_spelling(const std::string& engine, const std::vector<Word>& words, IsCorrect is_correct)
 {
-    // wczytaj zawartość pliku en.dict ("słownik języka angielskiego")    
-    // sprawdź poprawość pisowni następującego zdania:    
-    string input_text = "this is an exmple of very badd snetence";
+    std::vector<std::string_view> misspelled;
 
-    vector<string> words = regex_split(input_text);
+    auto start = std::chrono::high_resolution_clock::now();
 
-    ifstream in("en.dict");
+    for (const auto& tocheck : words)
+        if (!is_correct(tocheck))
+            misspelled.push_back(tocheck);
 
-    if (!in)
+    auto end = std::chrono::high_resolution_clock::now();
+
+    for (const auto& item : misspelled)
+        cout << item << " - " << "not exist" << endl;
+
+    std::cout << "Time (" << engine << "): " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n\n";
+}
+
+// checks documents in batches on all cores - misspellings are reported as "document:offset: word"
+//  - with no file names every line of stdin is a separate document
+void run_batch(const PerfectHashDictionary& dict, const std::vector<std::string>& file_names)
+{
+    const size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t batch_size = 10'000;
+
+    size_t document_count = 0;
+    size_t word_count = 0;
+    std::chrono::high_resolution_clock::duration check_time{};
+
+    auto check_batch = [&](const std::vector<std::string>& documents, auto print_name) {
+        auto start = std::chrono::high_resolution_clock::now();
+        const auto reports = check_documents(documents, dict, thread_count);
+        check_time += std::chrono::high_resolution_clock::now() - start;
+
+        for (size_t i = 0; i < reports.size(); ++i)
+        {
+            word_count += reports[i].word_count;
+
+            for (const auto& misspelling : reports[i].misspellings)
+            {
+                print_name(i);
+                std::cout << ":" << misspelling.offset << ": " << misspelling.word << "\n";
+            }
+        }
+
+        document_count += documents.size();
+    };
+
+    std::vector<std::string> documents;
+    documents.reserve(batch_size);
+
+    if (file_names.empty())
     {
-        std::exit(1);
+        std::ios::sync_with_stdio(false);
+
+        size_t first_line = 1;
+        std::string line;
+
+        while (true)
+        {
+            const bool has_line = static_cast<bool>(std::getline(std::cin, line));
+
+            if (has_line)
+                documents.push_back(std::move(line));
+
+            if (documents.size() == batch_size || (!has_line && !documents.empty()))
+            {
+                check_batch(documents, [first_line](size_t i) { std::cout << "<stdin>:" << first_line + i; });
+                first_line += documents.size();
+                documents.clear();
+            }
+
+            if (!has_line)
+                break;
+        }
+    }
+    else
+    {
+        for (size_t first = 0; first < file_names.size(); first += batch_size)
+        {
+            const size_t last = std::min(first + batch_size, file_names.size());
+
+            documents.clear();
+            for (size_t i = first; i < last; ++i)
+            {
+                ifstream fin(file_names[i], ios::in | ios::binary);
+
+                if (!fin)
+                    throw runtime_error("File "s + file_names[i] + " can't be opened");
+
+                documents.emplace_back(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+            }
+
+            check_batch(documents, [&file_names, first](size_t i) { std::cout << file_names[first + i]; });
+        }
     }
 
+    const double seconds = std::chrono::duration<double>(check_time).count();
 
-    std::unordered_set<std::string> dict;
+    std::cerr << "Checked " << document_count << " documents (" << word_count << " words) on " << thread_count << " threads in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(check_time).count() << "ms - "
+              << static_cast<size_t>(seconds > 0 ? word_count / seconds : 0) << " words/s\n";
+}
+
+std::vector<std::string> load_entries(const std::string& file_name)
+{
+    ifstream in(file_name);
+
+    if (!in)
+        throw runtime_error("File "s + file_name + " can't be opened");
+
+    std::vector<std::string> entries;
     std::string entry;
 
     while (in >> entry)
     {
-        dict.insert(entry);
+        entries.push_back(entry);
     }
 
-    std::cout << "Dictionary size: " << dict.size() << "\n";
-    
-    std::vector<std::string> misspelled;
+    return entries;
+}
 
-    auto start = std::chrono::high_resolution_clock::now();
+bool file_exists(const std::string& file_name)
+{
+    return static_cast<bool>(ifstream(file_name, ios::in | ios::binary));
+}
 
-    for (const auto& tocheck : words)
-        if (dict.find(tocheck) == dict.end())
-            misspelled.push_back(tocheck);
+// compile step: writes the dictionary image that can be mapped by PerfectHashDictionary::load()
+void save_dictionary_image(const std::vector<std::string>& entries, const std::string& image_file_name)
+{
+    const auto dict = build_dictionary("PerfectHashDictionary", [&] { return PerfectHashDictionary(entries); });
 
-    auto end = std::chrono::high_resolution_clock::now();
+    ofstream fout(image_file_name, ios::out | ios::binary);
 
-    for(const auto& item : misspelled)
-        cout << item << " - " << "not exist" << endl;
+    if (!fout)
+        throw runtime_error("File "s + image_file_name + " can't be opened");
 
-    std::cout << "Time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n\n";
+    dict.save(fout);
 
-    /////////////////////////////////////////////////////////////////
+    std::cout << "Dictionary image saved to " << image_file_name << " (" << dict.size() << " words)\n";
+}
 
-    std::vector<std::string> vec_dict(dict.begin(), dict.end());
-    std::sort(vec_dict.begin(), vec_dict.end());
-    misspelled.clear();
+// loads the suggestion index from the image file or builds it from the dictionary when there is no image
+SuggestionIndex load_suggestion_index(const std::vector<std::string>& entries, const std::string& image_file_name)
+{
+    if (ifstream fin{ image_file_name, ios::in | ios::binary })
+        return build_dictionary("SuggestionIndex - loaded from "s + image_file_name, [&] { return SuggestionIndex::load(fin); });
 
-    start = std::chrono::high_resolution_clock::now();
+    return build_dictionary("SuggestionIndex", [&] { return SuggestionIndex(entries); });
+}
 
-    for (const auto& tocheck : words)
-        if (!std::binary_search(vec_dict.begin(), vec_dict.end(), tocheck))
-            misspelled.push_back(tocheck);
+void save_suggestion_index(const std::vector<std::string>& entries, const std::string& image_file_name)
+{
+    const auto index = build_dictionary("SuggestionIndex", [&] { return SuggestionIndex(entries); });
 
-    end = std::chrono::high_resolution_clock::now();
+    ofstream fout(image_file_name, ios::out | ios::binary);
 
-    for (const auto& item : misspelled)
-        cout << item << " - " << "not exist" << endl;
+    if (!fout)
+        throw runtime_error("File "s + image_file_name + " can't be opened");
+
+    index.save(fout);
+
+    std::cout << "Suggestion index saved to " << image_file_name << " (" << index.memory_usage() / 1024 << " KB)\n";
+}
+
+// usage: spellcheck [--batch [file_name...] | --save-dictionary [image_file_name] | --save-suggestions [image_file_name]]
+int main(int argc, char* argv[])
+{
+    const std::string dictionary_file = "en.dict";
+    const std::string dictionary_image = "en.dict.image";
+    const std::string suggestion_image = "en.suggestions";
+
+    const std::string mode = (argc > 1) ? argv[1] : "";
+
+    if (mode == "--batch")
+    {
+        // short-lived jobs map the prebuilt image instead of parsing the dictionary
+        const auto dict = file_exists(dictionary_image) ? PerfectHashDictionary::load(dictionary_image) : PerfectHashDictionary(load_entries(dictionary_file));
+
+        run_batch(dict, std::vector<std::string>(argv + 2, argv + argc));
+        return 0;
+    }
+
+    if (mode == "--save-dictionary")
+    {
+        save_dictionary_image(load_entries(dictionary_file), (argc > 2) ? argv[2] : dictionary_image);
+        return 0;
+    }
+
+    if (mode == "--save-suggestions")
+    {
+        save_suggestion_index(load_entries(dictionary_file), (argc > 2) ? argv[2] : suggestion_image);
+        return 0;
+    }
+
+    // wczytaj zawartość pliku en.dict ("słownik języka angielskiego")    
+    // sprawdź poprawość pisowni następującego zdania:    
+    string input_text = "this is an exmple of very badd snetence";
+
+    const TokenRange tokens = split(input_text);
+    const vector<string_view> words(tokens.begin(), tokens.end());
+
+    const std::vector<std::string> entries = load_entries(dictionary_file);
+
+    std::cout << "Dictionary size: " << entries.size() << "\n";
+    const auto dict = build_dictionary("std::unordered_set", [&] { return std::unordered_set<std::string>(entries.begin(), entries.end()); });
+
+    const auto vec_dict = build_dictionary("sorted std::vector", [&] {
+        std::vector<std::string> vec_dict(entries.begin(), entries.end());
+        std::sort(vec_dict.begin(), vec_dict.end());
+        return vec_dict;
+    });
+
+    const auto flat_dict = build_dictionary("FlatStringSet", [&] {
+        FlatStringSet flat_dict;
+        for (const auto& item : entries)
+            flat_dict.insert(item);
+        return flat_dict;
+    });
+
+    const auto perfect_hash_dict = build_dictionary("PerfectHashDictionary", [&] { return PerfectHashDictionary(entries); });
+
+    if (file_exists(dictionary_image))
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        const auto mapped_dict = PerfectHashDictionary::load(dictionary_image);
+        const bool first_lookup = mapped_dict.contains(words.front());
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Startup to first lookup (" << dictionary_image << " mapped, " << mapped_dict.size() << " words, '" << words.front() << "' "
+                  << (first_lookup ? "found" : "not found") << "): " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n";
+    }
+
+    std::cout << "\n";
 
-    std::cout << "Time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n";
-}
\ No newline at end of file
+    // std::unordered_set<std::string> has no lookup by std::string_view in C++17 - queries are converted before timing
+    const vector<string> string_words(words.begin(), words.end());
+    check_spelling("std::unordered_set", string_words, [&](const std::string& word) { return dict.find(word) != dict.end(); });
+
+    check_spelling("sorted std::vector", words, [&](std::string_view word) { return std::binary_search(vec_dict.begin(), vec_dict.end(), word); });
+
+    check_spelling("FlatStringSet", words, [&](std::string_view word) { return flat_dict.contains(word); });
+
+    check_spelling("PerfectHashDictionary", words, [&](std::string_view word) { return perfect_hash_dict.contains(word); });
+
+    /////////////////////////////////////////////////////////////////
+
+    const auto suggestion_index = load_suggestion_index(entries, suggestion_image);
+
+    std::cout << "Suggestion index size: " << suggestion_index.memory_usage() / 1024 << " KB\n\n";
+
+    for (const auto& word : words)
+    {
+        if (perfect_hash_dict.contains(word))
+            continue;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        const auto suggestions = suggestion_index.suggest(word);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << word << " - did you mean:";
+        for (const auto& suggestion : suggestions)
+            std::cout << " " << suggestion.word << " (" << suggestion.distance << ")";
+        std::cout << " - " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us\n";
+    }
+}
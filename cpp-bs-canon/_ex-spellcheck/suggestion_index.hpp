@@ -0,0 +1,345 @@
+#ifndef SUGGESTION_INDEX_HPP
+#define SUGGESTION_INDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "binary_input.hpp"
+#include "perfect_hash_dictionary.hpp"
+
+// spelling suggestions with the symmetric delete algorithm (SymSpell)
+//  - build: for every word all variants of its prefix with up to max_distance characters deleted
+//    are generated and their hashes are stored in a sorted table pointing to the word
+//  - lookup: the same deletes are generated for the query, every word sharing a delete hash is a candidate,
+//    candidates are verified with the Damerau-Levenshtein (optimal string alignment) distance
+//  - the index keeps only hashes of deletes (hash collisions give extra candidates, never missing ones)
+//  - all data lives in a few flat arrays, so the index can be saved to and loaded from a binary image
+class SuggestionIndex
+{
+public:
+    struct Suggestion
+    {
+        std::string_view word;
+        size_t distance;
+    };
+
+    static constexpr size_t default_max_distance = 2;
+    static constexpr size_t default_prefix_length = 7;
+
+private:
+    uint32_t max_distance_ = default_max_distance;
+    uint32_t prefix_length_ = default_prefix_length;
+    std::string pool_;                     // all words
+    std::vector<uint32_t> word_offsets_;   // word i is pool_[word_offsets_[i], word_offsets_[i + 1])
+    std::vector<uint64_t> delete_hashes_;  // sorted, unique
+    std::vector<uint32_t> delete_offsets_; // words for delete_hashes_[i] are word_ids_[delete_offsets_[i], delete_offsets_[i + 1])
+    std::vector<uint32_t> word_ids_;
+
+    // hashes of all variants of the prefix of word with up to max_distance deleted characters (the prefix itself included)
+    void collect_deletes(std::string_view word, std::vector<uint64_t>& hashes) const
+    {
+        std::string variant(word.substr(0, prefix_length_));
+
+        hashes.clear();
+        collect_deletes(variant, 0, max_distance_, hashes);
+
+        std::sort(hashes.begin(), hashes.end());
+        hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    }
+
+    // variants are made in place in one buffer: a character is deleted, deeper deletes are hashed, the character is restored
+    //  - deletes at positions >= first only, so every set of deleted positions is visited once
+    static void collect_deletes(std::string& variant, size_t first, size_t deletes_left, std::vector<uint64_t>& hashes)
+    {
+        hashes.push_back(PerfectHashDictionary::hash(variant));
+
+        if (deletes_left == 0)
+            return;
+
+        for (size_t pos = first; pos < variant.size(); ++pos)
+        {
+            const char deleted = variant[pos];
+            variant.erase(pos, 1);
+            collect_deletes(variant, pos, deletes_left - 1, hashes);
+            variant.insert(pos, 1, deleted);
+        }
+    }
+
+    // optimal string alignment distance; returns max_distance + 1 when the distance is larger than max_distance
+    static size_t distance(std::string_view lhs, std::string_view rhs, size_t max_distance, std::vector<size_t>& rows)
+    {
+        const size_t lhs_size = lhs.size();
+        const size_t rhs_size = rhs.size();
+
+        if ((lhs_size > rhs_size ? lhs_size - rhs_size : rhs_size - lhs_size) > max_distance)
+            return max_distance + 1;
+
+        const size_t width = rhs_size + 1;
+        rows.assign(3 * width, 0);
+        size_t* prev_prev = rows.data();
+        size_t* prev = prev_prev + width;
+        size_t* current = prev + width;
+
+        for (size_t j = 0; j <= rhs_size; ++j)
+            prev[j] = j;
+
+        for (size_t i = 1; i <= lhs_size; ++i)
+        {
+            current[0] = i;
+            size_t row_min = current[0];
+
+            for (size_t j = 1; j <= rhs_size; ++j)
+            {
+                const size_t cost = (lhs[i - 1] == rhs[j - 1]) ? 0 : 1;
+                current[j] = std::min({ prev[j] + 1, current[j - 1] + 1, prev[j - 1] + cost });
+
+                if (i > 1 && j > 1 && lhs[i - 1] == rhs[j - 2] && lhs[i - 2] == rhs[j - 1])
+                    current[j] = std::min(current[j], prev_prev[j - 2] + 1);
+
+                row_min = std::min(row_min, current[j]);
+            }
+
+            if (row_min > max_distance)
+                return max_distance + 1;
+
+            std::swap(prev_prev, prev);
+            std::swap(prev, current);
+        }
+
+        return std::min(prev[rhs_size], max_distance + 1);
+    }
+
+    std::string_view word(uint32_t id) const
+    {
+        return std::string_view(pool_.data() + word_offsets_[id], word_offsets_[id + 1] - word_offsets_[id]);
+    }
+
+public:
+    SuggestionIndex() = default;
+
+    explicit SuggestionIndex(std::vector<std::string> words, size_t max_distance = default_max_distance, size_t prefix_length = default_prefix_length)
+        : max_distance_(static_cast<uint32_t>(max_distance)), prefix_length_(static_cast<uint32_t>(std::max(prefix_length, max_distance + 1)))
+    {
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+
+        word_offsets_.reserve(words.size() + 1);
+        for (const auto& w : words)
+        {
+            word_offsets_.push_back(static_cast<uint32_t>(pool_.size()));
+            pool_ += w;
+        }
+        word_offsets_.push_back(static_cast<uint32_t>(pool_.size()));
+
+        std::vector<std::pair<uint64_t, uint32_t>> deletes;
+        std::vector<uint64_t> hashes;
+
+        for (uint32_t id = 0; id < words.size(); ++id)
+        {
+            collect_deletes(words[id], hashes);
+
+            for (uint64_t hash : hashes)
+                deletes.emplace_back(hash, id);
+        }
+
+        std::sort(deletes.begin(), deletes.end());
+
+        word_ids_.reserve(deletes.size());
+        for (const auto& [hash, id] : deletes)
+        {
+            if (delete_hashes_.empty() || delete_hashes_.back() != hash)
+            {
+                delete_hashes_.push_back(hash);
+                delete_offsets_.push_back(static_cast<uint32_t>(word_ids_.size()));
+            }
+
+            word_ids_.push_back(id);
+        }
+        delete_offsets_.push_back(static_cast<uint32_t>(word_ids_.size()));
+
+        // a built index uses as much memory as a loaded one
+        pool_.shrink_to_fit();
+        delete_hashes_.shrink_to_fit();
+        delete_offsets_.shrink_to_fit();
+    }
+
+    size_t size() const
+    {
+        return word_offsets_.empty() ? 0 : word_offsets_.size() - 1;
+    }
+
+    size_t max_distance() const
+    {
+        return max_distance_;
+    }
+
+    // bytes used by the index
+    size_t memory_usage() const
+    {
+        return pool_.capacity() + word_offsets_.capacity() * sizeof(uint32_t) + delete_hashes_.capacity() * sizeof(uint64_t)
+            + delete_offsets_.capacity() * sizeof(uint32_t) + word_ids_.capacity() * sizeof(uint32_t);
+    }
+
+    // dictionary words within max_distance from query - the closest first, equally distant in alphabetical order
+    std::vector<Suggestion> suggest(std::string_view query, size_t max_count = 5) const
+    {
+        std::vector<uint64_t> hashes;
+        collect_deletes(query, hashes);
+
+        std::vector<uint32_t> candidates;
+
+        for (uint64_t hash : hashes)
+        {
+            auto it = std::lower_bound(delete_hashes_.begin(), delete_hashes_.end(), hash);
+
+            if (it != delete_hashes_.end() && *it == hash)
+            {
+                const size_t index = static_cast<size_t>(it - delete_hashes_.begin());
+                candidates.insert(candidates.end(), word_ids_.begin() + delete_offsets_[index], word_ids_.begin() + delete_offsets_[index + 1]);
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        std::vector<Suggestion> suggestions;
+        std::vector<size_t> rows;
+
+        for (uint32_t id : candidates)
+        {
+            const size_t dist = distance(query, word(id), max_distance_, rows);
+
+            if (dist <= max_distance_)
+                suggestions.push_back(Suggestion{ word(id), dist });
+        }
+
+        // candidates are sorted by id, i.e. alphabetically, so a stable sort by distance keeps the alphabetical order
+        std::stable_sort(suggestions.begin(), suggestions.end(), [](const Suggestion& lhs, const Suggestion& rhs) { return lhs.distance < rhs.distance; });
+
+        if (suggestions.size() > max_count)
+            suggestions.resize(max_count);
+
+        return suggestions;
+    }
+
+    // binary image: magic "SSPL", uint32 version, uint32 max distance, uint32 prefix length, then the arrays (each with uint64 size)
+    void save(std::ostream& out) const
+    {
+        out.write("SSPL", 4);
+        write_value<uint32_t>(out, 1);
+        write_value<uint32_t>(out, max_distance_);
+        write_value<uint32_t>(out, prefix_length_);
+        write_array(out, pool_);
+        write_array(out, word_offsets_);
+        write_array(out, delete_hashes_);
+        write_array(out, delete_offsets_);
+        write_array(out, word_ids_);
+    }
+
+    // reads an image written by save()
+    //  - the arrays are checked against each other, so a damaged image throws std::runtime_error
+    //    instead of sending suggest() out of bounds
+    static SuggestionIndex load(std::istream& in)
+    {
+        char magic[4];
+        if (!in.read(magic, 4) || std::string_view(magic, 4) != "SSPL")
+            throw std::runtime_error("Not a suggestion index image");
+
+        if (read_value<uint32_t>(in) != 1)
+            throw std::runtime_error("Unsupported suggestion index version");
+
+        SuggestionIndex index;
+        index.max_distance_ = read_value<uint32_t>(in);
+        index.prefix_length_ = read_value<uint32_t>(in);
+        read_array(in, index.pool_);
+        read_array(in, index.word_offsets_);
+        read_array(in, index.delete_hashes_);
+        read_array(in, index.delete_offsets_);
+        read_array(in, index.word_ids_);
+        index.check();
+
+        return index;
+    }
+
+private:
+    // offsets of range_count consecutive ranges of an array of size end: start at 0, never decrease, end inside the array
+    //  - a default constructed index has no offsets at all
+    static bool are_valid_offsets(const std::vector<uint32_t>& offsets, size_t range_count, size_t end)
+    {
+        if (offsets.empty())
+            return range_count == 0 && end == 0;
+
+        return offsets.size() == range_count + 1 && offsets.front() == 0 && std::is_sorted(offsets.begin(), offsets.end()) && offsets.back() <= end;
+    }
+
+    void check() const
+    {
+        const size_t word_count = size();
+
+        if (!are_valid_offsets(word_offsets_, word_count, pool_.size())
+            || !are_valid_offsets(delete_offsets_, delete_hashes_.size(), word_ids_.size())
+            || std::adjacent_find(delete_hashes_.begin(), delete_hashes_.end(), std::greater_equal<uint64_t>()) != delete_hashes_.end()
+            || std::any_of(word_ids_.begin(), word_ids_.end(), [word_count](uint32_t id) { return id >= word_count; }))
+            throw std::runtime_error("Suggestion index image is corrupted");
+    }
+
+    template <typename T>
+    static void write_value(std::ostream& out, T value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static T read_value(std::istream& in)
+    {
+        T value{};
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            throw std::runtime_error("Suggestion index image is truncated");
+        return value;
+    }
+
+    template <typename Container>
+    static void write_array(std::ostream& out, const Container& data)
+    {
+        write_value<uint64_t>(out, data.size());
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(data[0])));
+    }
+
+    // the size is checked against the bytes left in the stream before anything is allocated
+    template <typename Container>
+    static void read_array(std::istream& in, Container& data)
+    {
+        using Element = typename Container::value_type;
+
+        const uint64_t size = read_value<uint64_t>(in);
+        const std::streamoff remaining = BinaryInput::remaining_bytes(in);
+
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Element)
+            || (remaining >= 0 && size > static_cast<uint64_t>(remaining) / sizeof(Element)))
+            throw std::runtime_error("Suggestion index image is truncated");
+
+        auto read = [&in, &data](size_t offset, size_t count) {
+            if (!in.read(reinterpret_cast<char*>(data.data() + offset), static_cast<std::streamsize>(count * sizeof(Element))))
+                throw std::runtime_error("Suggestion index image is truncated");
+        };
+
+        if (remaining >= 0)
+        {
+            data.resize(static_cast<size_t>(size));
+            read(0, data.size());
+        }
+        else
+            BinaryInput::read_in_blocks(static_cast<size_t>(size), [&data](size_t count) { data.resize(count); }, read);
+    }
+};
+
+#endif // SUGGESTION_INDEX_HPP
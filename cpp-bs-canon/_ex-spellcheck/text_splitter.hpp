@@ -0,0 +1,116 @@
+#ifndef TEXT_SPLITTER_HPP
+#define TEXT_SPLITTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+// set of delimiter characters - membership test is a single lookup in a 256-entry table
+class Delimiters
+{
+    std::array<bool, 256> table_{};
+
+public:
+    constexpr explicit Delimiters(std::string_view chars)
+    {
+        for (char c : chars)
+            table_[static_cast<unsigned char>(c)] = true;
+    }
+
+    // the same characters as \s in std::regex (and std::isspace in the "C" locale)
+    static constexpr Delimiters whitespace()
+    {
+        return Delimiters(" \t\n\v\f\r");
+    }
+
+    constexpr bool contains(char c) const
+    {
+        return table_[static_cast<unsigned char>(c)];
+    }
+};
+
+// lazy range of tokens separated by one or more delimiters
+//  - tokens are string_views into the split text, so the text must outlive the range
+//  - empty tokens are skipped (as with the "\s+" regex)
+class TokenRange
+{
+    std::string_view text_;
+    Delimiters delimiters_;
+
+public:
+    class iterator
+    {
+        const char* token_begin_;
+        const char* token_end_;
+        const char* end_;
+        const Delimiters* delimiters_;
+
+        void find_token(const char* from)
+        {
+            while (from != end_ && delimiters_->contains(*from))
+                ++from;
+
+            token_begin_ = token_end_ = from;
+
+            while (token_end_ != end_ && !delimiters_->contains(*token_end_))
+                ++token_end_;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        iterator(const char* from, const char* end, const Delimiters* delimiters)
+            : end_(end), delimiters_(delimiters)
+        {
+            find_token(from);
+        }
+
+        std::string_view operator*() const
+        {
+            return std::string_view(token_begin_, static_cast<size_t>(token_end_ - token_begin_));
+        }
+
+        iterator& operator++()
+        {
+            find_token(token_end_);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator prev = *this;
+            ++(*this);
+            return prev;
+        }
+
+        bool operator==(const iterator& other) const { return token_begin_ == other.token_begin_; }
+        bool operator!=(const iterator& other) const { return token_begin_ != other.token_begin_; }
+    };
+
+    TokenRange(std::string_view text, const Delimiters& delimiters)
+        : text_(text), delimiters_(delimiters)
+    {
+    }
+
+    iterator begin() const
+    {
+        return iterator(text_.data(), text_.data() + text_.size(), &delimiters_);
+    }
+
+    iterator end() const
+    {
+        return iterator(text_.data() + text_.size(), text_.data() + text_.size(), &delimiters_);
+    }
+};
+
+inline TokenRange split(std::string_view text, const Delimiters& delimiters = Delimiters::whitespace())
+{
+    return TokenRange(text, delimiters);
+}
+
+#endif // TEXT_SPLITTER_HPP
@@ -0,0 +1,175 @@
+#ifndef VECTOR2D_HPP
+#define VECTOR2D_HPP
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace Vectors
+{
+	namespace Detail
+	{
+		// blocks deduction of T from a scalar argument, so that 2 * v works for BasicVector2D<double>
+		template <typename T>
+		struct Identity
+		{
+			using type = T;
+		};
+
+		template <typename T>
+		using Scalar = typename Identity<T>::type;
+	}
+
+	// 2D vector with coordinates of type T
+	//  - T: floating point type or a type with the same arithmetic operators (see vector2d_fixed.hpp)
+	template <typename T>
+	class BasicVector2D
+	{
+		T x_;
+		T y_;
+
+		static const BasicVector2D unit_x_;
+		static const BasicVector2D unit_y_;
+
+	public:
+		using value_type = T;
+
+		constexpr explicit BasicVector2D(T x = T{}, T y = T{})
+			: x_(x), y_(y)
+		{
+		}
+
+		constexpr T x() const { return x_; }
+
+		constexpr T y() const { return y_; }
+
+		T length() const
+		{
+			using std::sqrt;
+			return sqrt(x_ * x_ + y_ * y_);
+		}
+		
+		static constexpr const BasicVector2D& unit_x()
+		{
+			return unit_x_;
+
+		}
+
+		static constexpr const BasicVector2D& unit_y()
+		{
+			return unit_y_;
+
+		}
+
+		constexpr BasicVector2D operator*(T value) const
+		{
+			return BasicVector2D(x() * value, y() * value);
+		}
+
+		//Vector2D& operator*=(double value)
+		//{
+		//	x_ *= value;
+		//	y_ *= value;
+		//	
+		//	return *this;
+		//}
+	};
+
+	template <typename T>
+	constexpr BasicVector2D<T> BasicVector2D<T>::unit_x_(T(1.0), T(0.0));
+
+	template <typename T>
+	constexpr BasicVector2D<T> BasicVector2D<T>::unit_y_(T(0.0), T(1.0));
+
+	using Vector2D = BasicVector2D<double>;
+	using Vector2Df = BasicVector2D<float>;
+
+	template <typename T>
+	constexpr BasicVector2D<T> operator+(const BasicVector2D<T>& v1, const BasicVector2D<T>& v2)
+	{
+		return BasicVector2D<T>(v1.x() + v2.x(), v1.y() + v2.y());
+	}
+
+	template <typename T>
+	constexpr BasicVector2D<T> operator-(const BasicVector2D<T>& v1, const BasicVector2D<T>& v2)
+	{
+		return BasicVector2D<T>(v1.x() - v2.x(), v1.y() - v2.y());
+	}
+
+	template <typename T>
+	constexpr BasicVector2D<T> operator-(const BasicVector2D<T>& v1)
+	{
+		return BasicVector2D<T>(-v1.x(), -v1.y());
+	}
+
+	template <typename T>
+	constexpr bool operator==(const BasicVector2D<T>& v1, const BasicVector2D<T>& v2)
+	{
+		return ((v1.x() == v2.x()) && (v1.y() == v2.y()));
+	}
+	
+	template <typename T>
+	constexpr bool operator!=(const BasicVector2D<T>& v1, const BasicVector2D<T>& v2)
+	{
+		return !(v1 == v2);
+	}
+
+	template <typename T>
+	constexpr BasicVector2D<T> operator*(Detail::Scalar<T> value, const BasicVector2D<T>& v1)
+	{
+		return BasicVector2D<T>(v1.x() * value, v1.y() * value);
+	}
+
+	template <typename T>
+	constexpr T operator*(const BasicVector2D<T>& v1, const BasicVector2D<T>& v2)
+	{
+		return v1.x() * v2.x() + v1.y() * v2.y();
+	}
+
+	template <typename T>
+	constexpr BasicVector2D<T>& operator*=(BasicVector2D<T>& v, Detail::Scalar<T> value)
+	{
+		v = v * value;
+
+		return v;
+	}
+
+	template <typename T>
+	std::ostream& operator<<(std::ostream& out, const BasicVector2D<T>& vec)
+	{
+		out << std::fixed << std::setprecision(1) << "[" << vec.x() << ", " << vec.y() << "]";
+		return out;
+	}
+
+	template <typename T>
+	std::istream& operator>>(std::istream& in, BasicVector2D<T>& vec)
+	{
+		// format: "[1.0, 2.0]"
+		const char left_bracket = '[';
+		const char right_bracket = ']';
+		const char comma = ',';
+
+		char start, separator, end;
+		double x, y;
+
+		if (in >> start && start != left_bracket)
+		{
+			in.unget();
+			in.clear(std::ios_base::failbit);
+			return in;
+		}
+
+		in >> x >> separator >> y >> end;
+
+
+		if (!in || (separator != comma) || (end != right_bracket))
+			throw std::runtime_error("Stream reading error");
+
+		vec = BasicVector2D<T>(static_cast<T>(x), static_cast<T>(y));
+
+		return in;
+	}
+}
+
+#endif // VECTOR2D_HPP
@@ -0,0 +1,273 @@
+#ifndef VECTOR2D_ARRAY_HPP
+#define VECTOR2D_ARRAY_HPP
+
+#include <cassert>
+#include <cmath>
+#include <initializer_list>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VECTOR2D_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VECTOR2D_SIMD_SSE2
+#endif
+
+#include "vector2d.hpp"
+
+namespace Vectors
+{
+	template <typename E>
+	class Expression;
+
+	// batch of 2D vectors stored as a structure of arrays: all x coordinates, then all y coordinates
+	//  - kernels below process several vectors per instruction (AVX: 4, SSE2: 2, scalar fallback: 1)
+	class Vector2DArray
+	{
+		std::vector<double> x_;
+		std::vector<double> y_;
+
+	public:
+		Vector2DArray() = default;
+
+		explicit Vector2DArray(size_t size)
+			: x_(size), y_(size)
+		{
+		}
+
+		Vector2DArray(std::initializer_list<Vector2D> il)
+		{
+			reserve(il.size());
+			for (const auto& v : il)
+				push_back(v);
+		}
+
+		// evaluates an expression of arrays (see vector2d_expressions.hpp)
+		template <typename E>
+		Vector2DArray(const Expression<E>& expr);
+
+		template <typename E>
+		Vector2DArray& operator=(const Expression<E>& expr);
+
+		size_t size() const
+		{
+			return x_.size();
+		}
+
+		void reserve(size_t capacity)
+		{
+			x_.reserve(capacity);
+			y_.reserve(capacity);
+		}
+
+		void resize(size_t size)
+		{
+			x_.resize(size);
+			y_.resize(size);
+		}
+
+		void push_back(const Vector2D& v)
+		{
+			x_.push_back(v.x());
+			y_.push_back(v.y());
+		}
+
+		Vector2D operator[](size_t index) const
+		{
+			return Vector2D(x_[index], y_[index]);
+		}
+
+		void set(size_t index, const Vector2D& v)
+		{
+			x_[index] = v.x();
+			y_[index] = v.y();
+		}
+
+		double* xs() { return x_.data(); }
+		const double* xs() const { return x_.data(); }
+		double* ys() { return y_.data(); }
+		const double* ys() const { return y_.data(); }
+	};
+
+	namespace Simd
+	{
+#if defined(VECTOR2D_SIMD_AVX)
+		using Pack = __m256d;
+		constexpr size_t width = 4;
+
+		inline Pack load(const double* p) { return _mm256_loadu_pd(p); }
+		inline void store(double* p, Pack a) { _mm256_storeu_pd(p, a); }
+		inline Pack broadcast(double value) { return _mm256_set1_pd(value); }
+		inline Pack add(Pack a, Pack b) { return _mm256_add_pd(a, b); }
+		inline Pack sub(Pack a, Pack b) { return _mm256_sub_pd(a, b); }
+		inline Pack mul(Pack a, Pack b) { return _mm256_mul_pd(a, b); }
+		inline Pack sqrt(Pack a) { return _mm256_sqrt_pd(a); }
+		// 1 / a for a > 0, 0 otherwise
+		inline Pack safe_reciprocal(Pack a)
+		{
+			return _mm256_and_pd(_mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_GT_OQ), _mm256_div_pd(_mm256_set1_pd(1.0), a));
+		}
+#elif defined(VECTOR2D_SIMD_SSE2)
+		using Pack = __m128d;
+		constexpr size_t width = 2;
+
+		inline Pack load(const double* p) { return _mm_loadu_pd(p); }
+		inline void store(double* p, Pack a) { _mm_storeu_pd(p, a); }
+		inline Pack broadcast(double value) { return _mm_set1_pd(value); }
+		inline Pack add(Pack a, Pack b) { return _mm_add_pd(a, b); }
+		inline Pack sub(Pack a, Pack b) { return _mm_sub_pd(a, b); }
+		inline Pack mul(Pack a, Pack b) { return _mm_mul_pd(a, b); }
+		inline Pack sqrt(Pack a) { return _mm_sqrt_pd(a); }
+		inline Pack safe_reciprocal(Pack a)
+		{
+			return _mm_and_pd(_mm_cmpgt_pd(a, _mm_setzero_pd()), _mm_div_pd(_mm_set1_pd(1.0), a));
+		}
+#else
+		using Pack = double;
+		constexpr size_t width = 1;
+
+		inline Pack load(const double* p) { return *p; }
+		inline void store(double* p, Pack a) { *p = a; }
+		inline Pack broadcast(double value) { return value; }
+		inline Pack add(Pack a, Pack b) { return a + b; }
+		inline Pack sub(Pack a, Pack b) { return a - b; }
+		inline Pack mul(Pack a, Pack b) { return a * b; }
+		inline Pack sqrt(Pack a) { return std::sqrt(a); }
+#endif
+
+		inline double safe_reciprocal(double a)
+		{
+			return a > 0.0 ? 1.0 / a : 0.0;
+		}
+	}
+
+	// element-wise operations on batches - result must have the size of the arguments and may alias them
+	namespace Kernels
+	{
+		inline void add(const Vector2DArray& a, const Vector2DArray& b, Vector2DArray& result)
+		{
+			assert(a.size() == b.size() && a.size() == result.size());
+
+			const size_t n = a.size();
+			size_t i = 0;
+
+			for (; i + Simd::width <= n; i += Simd::width)
+			{
+				Simd::store(result.xs() + i, Simd::add(Simd::load(a.xs() + i), Simd::load(b.xs() + i)));
+				Simd::store(result.ys() + i, Simd::add(Simd::load(a.ys() + i), Simd::load(b.ys() + i)));
+			}
+
+			for (; i < n; ++i)
+			{
+				result.xs()[i] = a.xs()[i] + b.xs()[i];
+				result.ys()[i] = a.ys()[i] + b.ys()[i];
+			}
+		}
+
+		inline void sub(const Vector2DArray& a, const Vector2DArray& b, Vector2DArray& result)
+		{
+			assert(a.size() == b.size() && a.size() == result.size());
+
+			const size_t n = a.size();
+			size_t i = 0;
+
+			for (; i + Simd::width <= n; i += Simd::width)
+			{
+				Simd::store(result.xs() + i, Simd::sub(Simd::load(a.xs() + i), Simd::load(b.xs() + i)));
+				Simd::store(result.ys() + i, Simd::sub(Simd::load(a.ys() + i), Simd::load(b.ys() + i)));
+			}
+
+			for (; i < n; ++i)
+			{
+				result.xs()[i] = a.xs()[i] - b.xs()[i];
+				result.ys()[i] = a.ys()[i] - b.ys()[i];
+			}
+		}
+
+		inline void scale(const Vector2DArray& a, double value, Vector2DArray& result)
+		{
+			assert(a.size() == result.size());
+
+			const size_t n = a.size();
+			const Simd::Pack factor = Simd::broadcast(value);
+			size_t i = 0;
+
+			for (; i + Simd::width <= n; i += Simd::width)
+			{
+				Simd::store(result.xs() + i, Simd::mul(Simd::load(a.xs() + i), factor));
+				Simd::store(result.ys() + i, Simd::mul(Simd::load(a.ys() + i), factor));
+			}
+
+			for (; i < n; ++i)
+			{
+				result.xs()[i] = a.xs()[i] * value;
+				result.ys()[i] = a.ys()[i] * value;
+			}
+		}
+
+		// result[i] = a[i] * b[i] (dot product)
+		inline void dot(const Vector2DArray& a, const Vector2DArray& b, double* result)
+		{
+			assert(a.size() == b.size());
+
+			const size_t n = a.size();
+			size_t i = 0;
+
+			for (; i + Simd::width <= n; i += Simd::width)
+			{
+				const Simd::Pack xx = Simd::mul(Simd::load(a.xs() + i), Simd::load(b.xs() + i));
+				const Simd::Pack yy = Simd::mul(Simd::load(a.ys() + i), Simd::load(b.ys() + i));
+				Simd::store(result + i, Simd::add(xx, yy));
+			}
+
+			for (; i < n; ++i)
+				result[i] = a.xs()[i] * b.xs()[i] + a.ys()[i] * b.ys()[i];
+		}
+
+		inline void length(const Vector2DArray& a, double* result)
+		{
+			const size_t n = a.size();
+			size_t i = 0;
+
+			for (; i + Simd::width <= n; i += Simd::width)
+			{
+				const Simd::Pack x = Simd::load(a.xs() + i);
+				const Simd::Pack y = Simd::load(a.ys() + i);
+				Simd::store(result + i, Simd::sqrt(Simd::add(Simd::mul(x, x), Simd::mul(y, y))));
+			}
+
+			for (; i < n; ++i)
+				result[i] = std::sqrt(a.xs()[i] * a.xs()[i] + a.ys()[i] * a.ys()[i]);
+		}
+
+		// unit vectors with the directions of a - zero vectors stay zero
+		inline void normalize(const Vector2DArray& a, Vector2DArray& result)
+		{
+			assert(a.size() == result.size());
+
+			const size_t n = a.size();
+			size_t i = 0;
+
+			for (; i + Simd::width <= n; i += Simd::width)
+			{
+				const Simd::Pack x = Simd::load(a.xs() + i);
+				const Simd::Pack y = Simd::load(a.ys() + i);
+				const Simd::Pack inv_length = Simd::safe_reciprocal(Simd::sqrt(Simd::add(Simd::mul(x, x), Simd::mul(y, y))));
+				Simd::store(result.xs() + i, Simd::mul(x, inv_length));
+				Simd::store(result.ys() + i, Simd::mul(y, inv_length));
+			}
+
+			for (; i < n; ++i)
+			{
+				const double x = a.xs()[i];
+				const double y = a.ys()[i];
+				const double inv_length = Simd::safe_reciprocal(std::sqrt(x * x + y * y));
+				result.xs()[i] = x * inv_length;
+				result.ys()[i] = y * inv_length;
+			}
+		}
+	}
+}
+
+#endif // VECTOR2D_ARRAY_HPP
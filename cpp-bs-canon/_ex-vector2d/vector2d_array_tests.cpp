@@ -0,0 +1,188 @@
+#include <vector>
+
+#include "vector2d_array.hpp"
+#include "vector2d_test_helpers.hpp"
+
+using namespace std;
+
+using namespace Vectors;
+using TestHelpers::make_random_vectors;
+
+namespace
+{
+	std::vector<Vector2D> to_aos(const Vector2DArray& vectors)
+	{
+		std::vector<Vector2D> result;
+		result.reserve(vectors.size());
+
+		for (size_t i = 0; i < vectors.size(); ++i)
+			result.push_back(vectors[i]);
+
+		return result;
+	}
+}
+
+TEST_CASE("Vector2DArray")
+{
+	SECTION("stores vectors as separate x and y arrays")
+	{
+		Vector2DArray vectors = { Vector2D(1.0, 2.0), Vector2D(3.0, 4.0) };
+
+		REQUIRE(vectors.size() == 2);
+		REQUIRE(vectors[1] == Vector2D(3.0, 4.0));
+		REQUIRE(vectors.xs()[0] == 1.0);
+		REQUIRE(vectors.ys()[1] == 4.0);
+
+		vectors.set(0, Vector2D(5.0, 6.0));
+		REQUIRE(vectors[0] == Vector2D(5.0, 6.0));
+	}
+}
+
+TEST_CASE("Vector2DArray kernels give the same results as Vector2D operations")
+{
+	// sizes cover empty input, input shorter than one pack and the scalar remainder after full packs
+	for (size_t size : { 0u, 1u, 3u, 7u, 1001u })
+	{
+		DYNAMIC_SECTION("size " << size)
+		{
+			const Vector2DArray a = make_random_vectors(size, 665);
+			const Vector2DArray b = make_random_vectors(size, 42);
+			const auto a_aos = to_aos(a);
+			const auto b_aos = to_aos(b);
+
+			Vector2DArray result(size);
+			std::vector<double> values(size);
+
+			Kernels::add(a, b, result);
+			for (size_t i = 0; i < size; ++i)
+				REQUIRE(result[i] == a_aos[i] + b_aos[i]);
+
+			Kernels::sub(a, b, result);
+			for (size_t i = 0; i < size; ++i)
+				REQUIRE(result[i] == a_aos[i] - b_aos[i]);
+
+			Kernels::scale(a, 2.5, result);
+			for (size_t i = 0; i < size; ++i)
+				REQUIRE(result[i] == a_aos[i] * 2.5);
+
+			Kernels::dot(a, b, values.data());
+			for (size_t i = 0; i < size; ++i)
+				REQUIRE(values[i] == Approx(a_aos[i] * b_aos[i]));
+
+			Kernels::length(a, values.data());
+			for (size_t i = 0; i < size; ++i)
+				REQUIRE(values[i] == Approx(a_aos[i].length()));
+
+			Kernels::normalize(a, result);
+			for (size_t i = 0; i < size; ++i)
+			{
+				REQUIRE(result[i].length() == Approx(1.0));
+				REQUIRE(result[i].x() == Approx(a_aos[i].x() / a_aos[i].length()));
+				REQUIRE(result[i].y() == Approx(a_aos[i].y() / a_aos[i].length()));
+			}
+		}
+	}
+
+	SECTION("result may alias arguments")
+	{
+		Vector2DArray a = { Vector2D(1.0, 2.0), Vector2D(3.0, 4.0), Vector2D(5.0, 6.0) };
+
+		Kernels::add(a, a, a);
+
+		REQUIRE(a[2] == Vector2D(10.0, 12.0));
+	}
+
+	SECTION("normalize leaves zero vectors zero")
+	{
+		Vector2DArray a = { Vector2D(0.0, 0.0), Vector2D(3.0, 4.0), Vector2D(0.0, 0.0), Vector2D(0.0, 2.0), Vector2D(0.0, 0.0) };
+		Vector2DArray result(a.size());
+
+		Kernels::normalize(a, result);
+
+		REQUIRE(result[0] == Vector2D(0.0, 0.0));
+		REQUIRE(result[1].x() == Approx(0.6));
+		REQUIRE(result[1].y() == Approx(0.8));
+		REQUIRE(result[2] == Vector2D(0.0, 0.0));
+		REQUIRE(result[3] == Vector2D(0.0, 1.0));
+		REQUIRE(result[4] == Vector2D(0.0, 0.0));
+	}
+}
+
+TEST_CASE("Vector2DArray kernels vs std::vector<Vector2D>", "[.benchmark]")
+{
+	const size_t size = 1'000'000;
+
+	const Vector2DArray a = make_random_vectors(size, 665);
+	const Vector2DArray b = make_random_vectors(size, 42);
+	const auto a_aos = to_aos(a);
+	const auto b_aos = to_aos(b);
+
+	std::vector<Vector2D> result_aos(size);
+	Vector2DArray result(size);
+	std::vector<double> values(size);
+
+	BENCHMARK("add - std::vector<Vector2D>")
+	{
+		for (size_t i = 0; i < size; ++i)
+			result_aos[i] = a_aos[i] + b_aos[i];
+		return result_aos[size / 2].x();
+	};
+
+	BENCHMARK("add - Vector2DArray")
+	{
+		Kernels::add(a, b, result);
+		return result.xs()[size / 2];
+	};
+
+	BENCHMARK("scale - std::vector<Vector2D>")
+	{
+		for (size_t i = 0; i < size; ++i)
+			result_aos[i] = a_aos[i] * 2.5;
+		return result_aos[size / 2].x();
+	};
+
+	BENCHMARK("scale - Vector2DArray")
+	{
+		Kernels::scale(a, 2.5, result);
+		return result.xs()[size / 2];
+	};
+
+	BENCHMARK("dot - std::vector<Vector2D>")
+	{
+		for (size_t i = 0; i < size; ++i)
+			values[i] = a_aos[i] * b_aos[i];
+		return values[size / 2];
+	};
+
+	BENCHMARK("dot - Vector2DArray")
+	{
+		Kernels::dot(a, b, values.data());
+		return values[size / 2];
+	};
+
+	BENCHMARK("length - std::vector<Vector2D>")
+	{
+		for (size_t i = 0; i < size; ++i)
+			values[i] = a_aos[i].length();
+		return values[size / 2];
+	};
+
+	BENCHMARK("length - Vector2DArray")
+	{
+		Kernels::length(a, values.data());
+		return values[size / 2];
+	};
+
+	BENCHMARK("normalize - std::vector<Vector2D>")
+	{
+		for (size_t i = 0; i < size; ++i)
+			result_aos[i] = a_aos[i] * (1.0 / a_aos[i].length());
+		return result_aos[size / 2].x();
+	};
+
+	BENCHMARK("normalize - Vector2DArray")
+	{
+		Kernels::normalize(a, result);
+		return result.xs()[size / 2];
+	};
+}
@@ -0,0 +1,258 @@
+#ifndef VECTOR2D_EXPRESSIONS_HPP
+#define VECTOR2D_EXPRESSIONS_HPP
+
+#include <cassert>
+#include <type_traits>
+
+#include "vector2d.hpp"
+#include "vector2d_array.hpp"
+
+namespace Vectors
+{
+	// expression templates for arithmetic on Vector2DArray
+	//  - operators on arrays don't compute anything, they build a tree of nodes describing the expression
+	//  - the tree is evaluated element by element when it is assigned to a Vector2DArray:
+	//      result = -(v1 + v2 * (v2 * (-v1 * 4.0)));  // one loop, no intermediate arrays
+	//  - every element is computed with the ordinary Vector2D operators, so results are exactly the same
+	//  - a Vector2D or a number used in an expression with arrays is applied to every element
+	//  - nodes refer to arrays by reference - evaluate an expression before its arrays are destroyed
+	//    (don't keep expressions in auto variables with temporary arrays inside)
+	template <typename E>
+	class Expression
+	{
+	public:
+		const E& self() const
+		{
+			return static_cast<const E&>(*this);
+		}
+	};
+
+	namespace Detail
+	{
+		// leaf - array of vectors
+		class ArrayRef : public Expression<ArrayRef>
+		{
+			const Vector2DArray& array_;
+
+		public:
+			static constexpr bool is_broadcast = false;
+
+			explicit ArrayRef(const Vector2DArray& array)
+				: array_(array)
+			{
+			}
+
+			size_t size() const
+			{
+				return array_.size();
+			}
+
+			Vector2D operator[](size_t index) const
+			{
+				return array_[index];
+			}
+		};
+
+		// leaf - one value (Vector2D or number) used for every element
+		template <typename T>
+		class Broadcast : public Expression<Broadcast<T>>
+		{
+			T value_;
+
+		public:
+			static constexpr bool is_broadcast = true;
+
+			explicit Broadcast(const T& value)
+				: value_(value)
+			{
+			}
+
+			size_t size() const
+			{
+				return 0;
+			}
+
+			const T& operator[](size_t) const
+			{
+				return value_;
+			}
+		};
+
+		template <typename Op, typename Arg>
+		class UnaryNode : public Expression<UnaryNode<Op, Arg>>
+		{
+			Arg arg_;
+
+		public:
+			static constexpr bool is_broadcast = Arg::is_broadcast;
+
+			explicit UnaryNode(const Arg& arg)
+				: arg_(arg)
+			{
+			}
+
+			size_t size() const
+			{
+				return arg_.size();
+			}
+
+			auto operator[](size_t index) const
+			{
+				return Op{}(arg_[index]);
+			}
+		};
+
+		template <typename Op, typename Lhs, typename Rhs>
+		class BinaryNode : public Expression<BinaryNode<Op, Lhs, Rhs>>
+		{
+			Lhs lhs_;
+			Rhs rhs_;
+
+		public:
+			static constexpr bool is_broadcast = Lhs::is_broadcast && Rhs::is_broadcast;
+
+			BinaryNode(const Lhs& lhs, const Rhs& rhs)
+				: lhs_(lhs), rhs_(rhs)
+			{
+				assert(Lhs::is_broadcast || Rhs::is_broadcast || lhs_.size() == rhs_.size());
+			}
+
+			size_t size() const
+			{
+				return Lhs::is_broadcast ? rhs_.size() : lhs_.size();
+			}
+
+			auto operator[](size_t index) const
+			{
+				return Op{}(lhs_[index], rhs_[index]);
+			}
+		};
+
+		struct Negate
+		{
+			template <typename T>
+			auto operator()(const T& arg) const { return -arg; }
+		};
+
+		struct Plus
+		{
+			template <typename L, typename R>
+			auto operator()(const L& lhs, const R& rhs) const { return lhs + rhs; }
+		};
+
+		struct Minus
+		{
+			template <typename L, typename R>
+			auto operator()(const L& lhs, const R& rhs) const { return lhs - rhs; }
+		};
+
+		// Vector2D * Vector2D is the dot product, Vector2D * number scales the vector
+		struct Multiply
+		{
+			template <typename L, typename R>
+			auto operator()(const L& lhs, const R& rhs) const { return lhs * rhs; }
+		};
+
+		template <typename T>
+		constexpr bool is_array_operand_v = std::is_same_v<T, Vector2DArray> || std::is_base_of_v<Expression<T>, T>;
+
+		template <typename T>
+		constexpr bool is_operand_v = is_array_operand_v<T> || std::is_same_v<T, Vector2D> || std::is_arithmetic_v<T>;
+
+		// operators below are used only when at least one operand is an array or an expression
+		template <typename L, typename R>
+		using EnableIfLazy = std::enable_if_t<(is_array_operand_v<L> || is_array_operand_v<R>) && is_operand_v<L> && is_operand_v<R>>;
+
+		inline ArrayRef as_expression(const Vector2DArray& array)
+		{
+			return ArrayRef(array);
+		}
+
+		template <typename E>
+		const E& as_expression(const Expression<E>& expr)
+		{
+			return expr.self();
+		}
+
+		inline Broadcast<Vector2D> as_expression(const Vector2D& value)
+		{
+			return Broadcast<Vector2D>(value);
+		}
+
+		template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+		Broadcast<double> as_expression(T value)
+		{
+			return Broadcast<double>(static_cast<double>(value));
+		}
+
+		template <typename T>
+		using ExpressionOf = std::decay_t<decltype(as_expression(std::declval<const T&>()))>;
+
+		template <typename Op, typename L, typename R>
+		BinaryNode<Op, ExpressionOf<L>, ExpressionOf<R>> make_binary(const L& lhs, const R& rhs)
+		{
+			return BinaryNode<Op, ExpressionOf<L>, ExpressionOf<R>>(as_expression(lhs), as_expression(rhs));
+		}
+	}
+
+	template <typename E>
+	Detail::UnaryNode<Detail::Negate, E> operator-(const Expression<E>& arg)
+	{
+		return Detail::UnaryNode<Detail::Negate, E>(arg.self());
+	}
+
+	inline Detail::UnaryNode<Detail::Negate, Detail::ArrayRef> operator-(const Vector2DArray& arg)
+	{
+		return Detail::UnaryNode<Detail::Negate, Detail::ArrayRef>(Detail::ArrayRef(arg));
+	}
+
+	template <typename L, typename R, typename = Detail::EnableIfLazy<L, R>>
+	auto operator+(const L& lhs, const R& rhs)
+	{
+		return Detail::make_binary<Detail::Plus>(lhs, rhs);
+	}
+
+	template <typename L, typename R, typename = Detail::EnableIfLazy<L, R>>
+	auto operator-(const L& lhs, const R& rhs)
+	{
+		return Detail::make_binary<Detail::Minus>(lhs, rhs);
+	}
+
+	template <typename L, typename R, typename = Detail::EnableIfLazy<L, R>>
+	auto operator*(const L& lhs, const R& rhs)
+	{
+		return Detail::make_binary<Detail::Multiply>(lhs, rhs);
+	}
+
+	template <typename E>
+	Vector2DArray::Vector2DArray(const Expression<E>& expr)
+	{
+		*this = expr;
+	}
+
+	// single pass over all elements - the array may appear in the expression itself (e.g. a = a + b)
+	template <typename E>
+	Vector2DArray& Vector2DArray::operator=(const Expression<E>& expr)
+	{
+		static_assert(std::is_same_v<std::decay_t<decltype(expr.self()[0])>, Vector2D>, "expression must give vectors, not numbers");
+
+		const E& e = expr.self();
+		const size_t n = e.size();
+
+		resize(n);
+
+		double* xs = x_.data();
+		double* ys = y_.data();
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const Vector2D v = e[i];
+			xs[i] = v.x();
+			ys[i] = v.y();
+		}
+
+		return *this;
+	}
+}
+
+#endif // VECTOR2D_EXPRESSIONS_HPP
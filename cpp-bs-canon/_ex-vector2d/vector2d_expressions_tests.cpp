@@ -0,0 +1,112 @@
+#include <vector>
+
+#include "vector2d_expressions.hpp"
+#include "vector2d_test_helpers.hpp"
+
+using namespace std;
+
+using namespace Vectors;
+using TestHelpers::make_random_vectors;
+
+TEST_CASE("expression templates")
+{
+	const Vector2DArray v1 = make_random_vectors(1001, 665);
+	const Vector2DArray v2 = make_random_vectors(1001, 42);
+
+	SECTION("give exactly the same results as Vector2D operators")
+	{
+		Vector2DArray result = -(v1 + v2 * (v2 * (-v1 * 4.0)));
+
+		REQUIRE(result.size() == v1.size());
+		for (size_t i = 0; i < v1.size(); ++i)
+			REQUIRE(result[i] == -(v1[i] + v2[i] * (v2[i] * (-v1[i] * 4.0))));
+
+		result = 2.0 * v1 - v2 * 0.5;
+		for (size_t i = 0; i < v1.size(); ++i)
+			REQUIRE(result[i] == 2.0 * v1[i] - v2[i] * 0.5);
+	}
+
+	SECTION("Vector2D operand is applied to every element")
+	{
+		const Vector2D offset(1.0, -2.0);
+
+		Vector2DArray result = v1 + offset;
+		for (size_t i = 0; i < v1.size(); ++i)
+			REQUIRE(result[i] == v1[i] + offset);
+
+		// dot product with a fixed vector scales every element
+		result = v1 * (v2 * Vector2D::unit_x());
+		for (size_t i = 0; i < v1.size(); ++i)
+			REQUIRE(result[i] == v1[i] * (v2[i] * Vector2D::unit_x()));
+	}
+
+	SECTION("array may be used in the expression assigned to it")
+	{
+		Vector2DArray a = v1;
+
+		a = a + a * 2 - v2;
+
+		for (size_t i = 0; i < v1.size(); ++i)
+			REQUIRE(a[i] == v1[i] + v1[i] * 2 - v2[i]);
+	}
+
+	SECTION("assignment resizes the target")
+	{
+		Vector2DArray result;
+
+		result = -v1;
+
+		REQUIRE(result.size() == v1.size());
+		REQUIRE(result[0] == -v1[0]);
+	}
+
+	SECTION("Vector2D arithmetic is not affected")
+	{
+		const Vector2D a(1.0, 2.0);
+		const Vector2D b(3.0, 4.0);
+
+		static_assert(std::is_same_v<decltype(a + b), Vector2D>);
+		static_assert(std::is_same_v<decltype(a * b), double>);
+
+		REQUIRE(-(a + b * (b * (-a * 4.0))) == Vector2D(131.0, 174.0));
+	}
+}
+
+TEST_CASE("expression templates vs chained kernels", "[.benchmark]")
+{
+	const size_t size = 1'000'000;
+
+	const Vector2DArray v1 = make_random_vectors(size, 665);
+	const Vector2DArray v2 = make_random_vectors(size, 42);
+
+	Vector2DArray result(size);
+
+	BENCHMARK("-(v1 + v2 * (v2 * (-v1 * 4.0))) - Vector2D loop")
+	{
+		for (size_t i = 0; i < size; ++i)
+			result.set(i, -(v1[i] + v2[i] * (v2[i] * (-v1[i] * 4.0))));
+		return result[size / 2].x();
+	};
+
+	BENCHMARK("-(v1 + v2 * (v2 * (-v1 * 4.0))) - kernel per operation")
+	{
+		// every operation is a separate pass that writes an intermediate array
+		Vector2DArray scaled(size);
+		std::vector<double> dots(size);
+		Vector2DArray products(size);
+
+		Kernels::scale(v1, -4.0, scaled);
+		Kernels::dot(v2, scaled, dots.data());
+		for (size_t i = 0; i < size; ++i)
+			products.set(i, v2[i] * dots[i]);
+		Kernels::add(v1, products, result);
+		Kernels::scale(result, -1.0, result);
+		return result[size / 2].x();
+	};
+
+	BENCHMARK("-(v1 + v2 * (v2 * (-v1 * 4.0))) - expression template")
+	{
+		result = -(v1 + v2 * (v2 * (-v1 * 4.0)));
+		return result[size / 2].x();
+	};
+}
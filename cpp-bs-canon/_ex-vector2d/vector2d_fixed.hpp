@@ -0,0 +1,119 @@
+#ifndef VECTOR2D_FIXED_HPP
+#define VECTOR2D_FIXED_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+#include "vector2d.hpp"
+
+namespace Vectors
+{
+	// signed Q16.16 fixed-point number stored in 32 bits
+	//  - range [-32768, 32768), resolution 1/65536
+	//  - products are computed in 64 bits and truncated towards negative infinity; results out of range wrap
+	class Fixed
+	{
+		int32_t raw_;
+
+		// sums are computed in unsigned arithmetic, where overflow is defined
+		static constexpr int32_t wrap(uint32_t value)
+		{
+			return static_cast<int32_t>(value);
+		}
+
+		// converting a double out of the range of int32_t is undefined behaviour - it is clamped first
+		static constexpr int32_t to_raw(double value)
+		{
+			const double scaled = value * one + (value < 0 ? -0.5 : 0.5);
+
+			if (scaled != scaled) // NaN
+				return 0;
+			if (scaled <= std::numeric_limits<int32_t>::min())
+				return std::numeric_limits<int32_t>::min();
+			if (scaled >= std::numeric_limits<int32_t>::max())
+				return std::numeric_limits<int32_t>::max();
+
+			return static_cast<int32_t>(scaled);
+		}
+
+	public:
+		static constexpr int fraction_bits = 16;
+		static constexpr int32_t one = int32_t{ 1 } << fraction_bits;
+
+		constexpr Fixed() : raw_(0)
+		{
+		}
+
+		// rounds to the nearest representable value
+		//  - valid domain is [-32768, 32768): values outside saturate to the lowest or the highest
+		//    representable value, NaN converts to zero
+		constexpr explicit Fixed(double value) : raw_(to_raw(value))
+		{
+		}
+
+		static constexpr Fixed from_raw(int32_t raw)
+		{
+			Fixed result;
+			result.raw_ = raw;
+			return result;
+		}
+
+		// the highest representable value, just below 32768
+		static constexpr Fixed max()
+		{
+			return from_raw(std::numeric_limits<int32_t>::max());
+		}
+
+		constexpr int32_t raw() const { return raw_; }
+
+		constexpr explicit operator double() const { return static_cast<double>(raw_) / one; }
+
+		constexpr Fixed operator-() const { return from_raw(wrap(0u - static_cast<uint32_t>(raw_))); }
+
+		friend constexpr Fixed operator+(Fixed a, Fixed b) { return from_raw(wrap(static_cast<uint32_t>(a.raw_) + static_cast<uint32_t>(b.raw_))); }
+
+		friend constexpr Fixed operator-(Fixed a, Fixed b) { return from_raw(wrap(static_cast<uint32_t>(a.raw_) - static_cast<uint32_t>(b.raw_))); }
+
+		friend constexpr Fixed operator*(Fixed a, Fixed b)
+		{
+			return from_raw(static_cast<int32_t>((static_cast<int64_t>(a.raw_) * b.raw_) >> fraction_bits));
+		}
+
+		friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw_ == b.raw_; }
+
+		friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw_ != b.raw_; }
+
+		friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw_ < b.raw_; }
+
+		friend std::ostream& operator<<(std::ostream& out, Fixed value)
+		{
+			return out << static_cast<double>(value);
+		}
+	};
+
+	inline Fixed sqrt(Fixed value)
+	{
+		return Fixed(std::sqrt(static_cast<double>(value)));
+	}
+
+	// x * x + y * y overflows Q16.16 already for coordinates above 181 - squares are summed in unsigned 64 bits instead
+	//  - lengths out of range saturate to Fixed::max() like Fixed(double)
+	template <>
+	inline Fixed BasicVector2D<Fixed>::length() const
+	{
+		const uint64_t squared = static_cast<uint64_t>(static_cast<int64_t>(x_.raw()) * x_.raw())
+			+ static_cast<uint64_t>(static_cast<int64_t>(y_.raw()) * y_.raw());
+		const double raw_length = std::sqrt(static_cast<double>(squared)) + 0.5;
+
+		if (raw_length >= static_cast<double>(Fixed::max().raw()))
+			return Fixed::max();
+
+		return Fixed::from_raw(static_cast<int32_t>(raw_length));
+	}
+
+	using Vector2DFixed = BasicVector2D<Fixed>;
+}
+
+#endif // VECTOR2D_FIXED_HPP
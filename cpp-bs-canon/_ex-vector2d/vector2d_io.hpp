@@ -0,0 +1,260 @@
+#ifndef VECTOR2D_IO_HPP
+#define VECTOR2D_IO_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "binary_input.hpp"
+#include "vector2d.hpp"
+#include "vector2d_array.hpp"
+
+// bulk i/o for files of vectors
+//  - text: one "[x, y]" per line (the format of operator<< and operator>>),
+//    numbers are written with std::to_chars (shortest form that reads back to the same double)
+//    and parsed with std::from_chars - no locale, no stream state changes, no exception per element
+//  - binary: magic "V2DA", uint32 version, uint64 count, then count x coordinates and count y coordinates,
+//    all little-endian (IEEE 754 doubles) regardless of the platform
+namespace Vector2DIO
+{
+	const char magic[4] = { 'V', '2', 'D', 'A' };
+	const uint32_t version = 1;
+
+	// result of parsing text - on error vectors holds the vectors read before error_offset
+	struct TextReadResult
+	{
+		bool ok = true;
+		size_t count = 0;        // vectors read
+		size_t error_offset = 0; // position of the first malformed vector in the text
+	};
+
+	namespace Detail
+	{
+		inline bool is_space(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+		}
+
+		inline const char* skip_spaces(const char* first, const char* last)
+		{
+			while (first != last && is_space(*first))
+				++first;
+			return first;
+		}
+
+		// parses "[x, y]" at first - returns the position after it or nullptr
+		inline const char* parse_vector(const char* first, const char* last, double& x, double& y)
+		{
+			if (first == last || *first != '[')
+				return nullptr;
+
+			first = skip_spaces(first + 1, last);
+			auto [x_end, x_error] = std::from_chars(first, last, x);
+			if (x_error != std::errc())
+				return nullptr;
+
+			first = skip_spaces(x_end, last);
+			if (first == last || *first != ',')
+				return nullptr;
+
+			first = skip_spaces(first + 1, last);
+			auto [y_end, y_error] = std::from_chars(first, last, y);
+			if (y_error != std::errc())
+				return nullptr;
+
+			first = skip_spaces(y_end, last);
+			if (first == last || *first != ']')
+				return nullptr;
+
+			return first + 1;
+		}
+
+		inline bool is_little_endian()
+		{
+			const uint16_t value = 1;
+			unsigned char first_byte;
+			std::memcpy(&first_byte, &value, 1);
+			return first_byte == 1;
+		}
+
+		template <typename T>
+		void write_le(std::ostream& out, T value)
+		{
+			char bytes[sizeof(T)];
+			for (size_t i = 0; i < sizeof(T); ++i)
+				bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+			out.write(bytes, sizeof(T));
+		}
+
+		template <typename T>
+		T read_le(std::istream& in)
+		{
+			unsigned char bytes[sizeof(T)];
+			if (!in.read(reinterpret_cast<char*>(bytes), sizeof(T)))
+				throw std::runtime_error("Vector file is truncated");
+
+			T value = 0;
+			for (size_t i = 0; i < sizeof(T); ++i)
+				value |= static_cast<T>(bytes[i]) << (8 * i);
+			return value;
+		}
+
+		inline void write_doubles(std::ostream& out, const double* values, size_t count)
+		{
+			if (is_little_endian())
+			{
+				out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count * sizeof(double)));
+				return;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				uint64_t bits;
+				std::memcpy(&bits, &values[i], sizeof(bits));
+				write_le(out, bits);
+			}
+		}
+
+		inline void read_doubles(std::istream& in, double* values, size_t count)
+		{
+			if (is_little_endian())
+			{
+				if (!in.read(reinterpret_cast<char*>(values), static_cast<std::streamsize>(count * sizeof(double))))
+					throw std::runtime_error("Vector file is truncated");
+				return;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint64_t bits = read_le<uint64_t>(in);
+				std::memcpy(&values[i], &bits, sizeof(bits));
+			}
+		}
+	}
+
+	// appends vectors from text to vectors - stops at the first malformed vector
+	inline TextReadResult read_text(std::string_view text, Vectors::Vector2DArray& vectors)
+	{
+		TextReadResult result;
+
+		const char* first = text.data();
+		const char* const last = text.data() + text.size();
+
+		for (first = Detail::skip_spaces(first, last); first != last; first = Detail::skip_spaces(first, last))
+		{
+			double x, y;
+			const char* next = Detail::parse_vector(first, last, x, y);
+
+			if (!next)
+			{
+				result.ok = false;
+				result.error_offset = static_cast<size_t>(first - text.data());
+				break;
+			}
+
+			vectors.push_back(Vectors::Vector2D(x, y));
+			++result.count;
+			first = next;
+		}
+
+		return result;
+	}
+
+	inline TextReadResult read_text(std::istream& in, Vectors::Vector2DArray& vectors)
+	{
+		const std::string text{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+		return read_text(text, vectors);
+	}
+
+	inline void write_text(std::ostream& out, const Vectors::Vector2DArray& vectors)
+	{
+		const size_t flush_size = 64 * 1024;
+		const size_t max_line_size = 2 * 32 + 5; // two doubles in the shortest form, "[", ", ", "]\n"
+
+		std::string buffer;
+		buffer.reserve(flush_size + max_line_size);
+
+		char line[max_line_size];
+
+		for (size_t i = 0; i < vectors.size(); ++i)
+		{
+			char* pos = line;
+			*pos++ = '[';
+			pos = std::to_chars(pos, line + max_line_size, vectors.xs()[i]).ptr;
+			*pos++ = ',';
+			*pos++ = ' ';
+			pos = std::to_chars(pos, line + max_line_size, vectors.ys()[i]).ptr;
+			*pos++ = ']';
+			*pos++ = '\n';
+
+			buffer.append(line, pos);
+
+			if (buffer.size() >= flush_size)
+			{
+				out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				buffer.clear();
+			}
+		}
+
+		out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	}
+
+	inline void write_binary(std::ostream& out, const Vectors::Vector2DArray& vectors)
+	{
+		out.write(magic, sizeof(magic));
+		Detail::write_le<uint32_t>(out, version);
+		Detail::write_le<uint64_t>(out, vectors.size());
+		Detail::write_doubles(out, vectors.xs(), vectors.size());
+		Detail::write_doubles(out, vectors.ys(), vectors.size());
+	}
+
+	// replaces the content of vectors with the vectors from a binary file
+	//  - a corrupted count throws "Vector file is truncated" instead of allocating gigabytes
+	//  - vectors are changed only if the whole file is read
+	inline void read_binary(std::istream& in, Vectors::Vector2DArray& vectors)
+	{
+		char header[sizeof(magic)];
+		if (!in.read(header, sizeof(header)) || std::memcmp(header, magic, sizeof(magic)) != 0)
+			throw std::runtime_error("Not a vector file");
+
+		if (Detail::read_le<uint32_t>(in) != version)
+			throw std::runtime_error("Unsupported vector file version");
+
+		const uint64_t count = Detail::read_le<uint64_t>(in);
+		const std::streamoff remaining = BinaryInput::remaining_bytes(in);
+
+		if (count > std::numeric_limits<size_t>::max() / (2 * sizeof(double))
+			|| (remaining >= 0 && count > static_cast<uint64_t>(remaining) / (2 * sizeof(double))))
+			throw std::runtime_error("Vector file is truncated");
+
+		const size_t size = static_cast<size_t>(count);
+		Vectors::Vector2DArray loaded;
+
+		if (remaining >= 0)
+		{
+			loaded.resize(size);
+			Detail::read_doubles(in, loaded.xs(), size);
+		}
+		else
+		{
+			BinaryInput::read_in_blocks(size, [&loaded](size_t n) { loaded.resize(n); },
+				[&](size_t offset, size_t n) { Detail::read_doubles(in, loaded.xs() + offset, n); });
+		}
+
+		Detail::read_doubles(in, loaded.ys(), size);
+
+		vectors = std::move(loaded);
+	}
+}
+
+#endif // VECTOR2D_IO_HPP
@@ -0,0 +1,272 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+#include "vector2d_io.hpp"
+#include "vector2d_test_helpers.hpp"
+
+using namespace std;
+
+using namespace Vectors;
+using TestHelpers::make_random_vectors;
+
+namespace
+{
+	bool same_bits(double a, double b)
+	{
+		return std::memcmp(&a, &b, sizeof(double)) == 0;
+	}
+
+	bool same_bits(const Vector2DArray& a, const Vector2DArray& b)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (size_t i = 0; i < a.size(); ++i)
+			if (!same_bits(a.xs()[i], b.xs()[i]) || !same_bits(a.ys()[i], b.ys()[i]))
+				return false;
+
+		return true;
+	}
+
+	// input buffer without seeking - like a pipe, the size of its content is unknown
+	struct UnseekableBuffer : std::streambuf
+	{
+		explicit UnseekableBuffer(std::string& content)
+		{
+			setg(content.data(), content.data(), content.data() + content.size());
+		}
+	};
+
+	Vector2DArray make_edge_cases()
+	{
+		return Vector2DArray{
+			Vector2D(0.0, -0.0),
+			Vector2D(0.1, 1.0 / 3.0),
+			Vector2D(std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()),
+			Vector2D(std::numeric_limits<double>::min(), std::numeric_limits<double>::denorm_min()),
+			Vector2D(std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()),
+			Vector2D(1e300, -1e-300)
+		};
+	}
+}
+
+TEST_CASE("Vector2DIO - text")
+{
+	SECTION("round trip is exact")
+	{
+		for (const auto& vectors : { make_random_vectors(10'000, 665), make_edge_cases(), Vector2DArray{} })
+		{
+			stringstream stream;
+			Vector2DIO::write_text(stream, vectors);
+
+			Vector2DArray loaded;
+			const auto result = Vector2DIO::read_text(stream, loaded);
+
+			REQUIRE(result.ok);
+			REQUIRE(result.count == vectors.size());
+			REQUIRE(same_bits(loaded, vectors));
+		}
+	}
+
+	SECTION("writing doesn't change the state of the stream")
+	{
+		stringstream stream;
+		stream << 1.25 << " ";
+
+		Vector2DIO::write_text(stream, Vector2DArray{ Vector2D(1.5, 2.0) });
+		stream << 3.125;
+
+		REQUIRE(stream.str() == "1.25 [1.5, 2]\n3.125");
+	}
+
+	SECTION("reads output of operator<<")
+	{
+		stringstream stream;
+		stream << Vector2D(1.0, 2.5) << "\n" << Vector2D(-3.0, 4.0) << "  " << Vector2D(0.5, 0.0);
+
+		Vector2DArray loaded;
+		const auto result = Vector2DIO::read_text(stream.str(), loaded);
+
+		REQUIRE(result.ok);
+		REQUIRE(loaded.size() == 3);
+		REQUIRE(loaded[0] == Vector2D(1.0, 2.5));
+		REQUIRE(loaded[1] == Vector2D(-3.0, 4.0));
+		REQUIRE(loaded[2] == Vector2D(0.5, 0.0));
+	}
+
+	SECTION("malformed vector stops reading without exception")
+	{
+		const std::string text = "[1, 2]\n[ 3 , 4 ]\n[5; 6]\n[7, 8]\n";
+
+		Vector2DArray loaded;
+		const auto result = Vector2DIO::read_text(text, loaded);
+
+		REQUIRE_FALSE(result.ok);
+		REQUIRE(result.count == 2);
+		REQUIRE(result.error_offset == text.find("[5"));
+		REQUIRE(loaded.size() == 2);
+		REQUIRE(loaded[1] == Vector2D(3.0, 4.0));
+
+		for (const std::string bad : { "1, 2", "[1, 2", "[x, 2]", "[1 2]", "[1, 2]]" })
+		{
+			Vector2DArray vectors;
+			REQUIRE_FALSE(Vector2DIO::read_text(bad, vectors).ok);
+		}
+	}
+}
+
+TEST_CASE("Vector2DIO - binary")
+{
+	SECTION("round trip is exact")
+	{
+		for (const auto& vectors : { make_random_vectors(10'000, 665), make_edge_cases(), Vector2DArray{} })
+		{
+			stringstream stream(ios::in | ios::out | ios::binary);
+			Vector2DIO::write_binary(stream, vectors);
+
+			Vector2DArray loaded{ Vector2D(1.0, 1.0) };
+			Vector2DIO::read_binary(stream, loaded);
+
+			REQUIRE(same_bits(loaded, vectors));
+		}
+	}
+
+	SECTION("layout is little-endian")
+	{
+		stringstream stream(ios::in | ios::out | ios::binary);
+		Vector2DIO::write_binary(stream, Vector2DArray{ Vector2D(1.0, -2.0) });
+
+		const std::string expected("V2DA"
+			"\x01\x00\x00\x00"
+			"\x01\x00\x00\x00\x00\x00\x00\x00"
+			"\x00\x00\x00\x00\x00\x00\xF0\x3F"
+			"\x00\x00\x00\x00\x00\x00\x00\xC0", 32);
+
+		REQUIRE(stream.str() == expected);
+	}
+
+	SECTION("corrupted file")
+	{
+		stringstream stream(ios::in | ios::out | ios::binary);
+		Vector2DIO::write_binary(stream, make_random_vectors(10, 665));
+
+		const std::string image = stream.str();
+		Vector2DArray loaded;
+
+		stringstream truncated(image.substr(0, image.size() - 1));
+		REQUIRE_THROWS_AS(Vector2DIO::read_binary(truncated, loaded), std::runtime_error);
+
+		stringstream wrong_magic("V2DX" + image.substr(4));
+		REQUIRE_THROWS_AS(Vector2DIO::read_binary(wrong_magic, loaded), std::runtime_error);
+	}
+
+	SECTION("corrupted count throws without allocating and leaves vectors unchanged")
+	{
+		stringstream stream(ios::in | ios::out | ios::binary);
+		Vector2DIO::write_binary(stream, make_random_vectors(10, 665));
+
+		std::string image = stream.str();
+		image.replace(8, 8, 8, '\x7F'); // count ~ 9 * 10^18
+
+		const Vector2DArray original = make_random_vectors(3, 667);
+
+		Vector2DArray loaded = original;
+		stringstream corrupted(image);
+		REQUIRE_THROWS_AS(Vector2DIO::read_binary(corrupted, loaded), std::runtime_error);
+		REQUIRE(same_bits(loaded, original));
+
+		UnseekableBuffer buffer(image);
+		std::istream unseekable(&buffer);
+		REQUIRE_THROWS_AS(Vector2DIO::read_binary(unseekable, loaded), std::runtime_error);
+		REQUIRE(same_bits(loaded, original));
+	}
+
+	SECTION("streams without size are read in blocks")
+	{
+		const Vector2DArray vectors = make_random_vectors(100'000, 665);
+
+		stringstream stream(ios::in | ios::out | ios::binary);
+		Vector2DIO::write_binary(stream, vectors);
+
+		std::string image = stream.str();
+		UnseekableBuffer buffer(image);
+		std::istream unseekable(&buffer);
+
+		Vector2DArray loaded;
+		Vector2DIO::read_binary(unseekable, loaded);
+
+		REQUIRE(same_bits(loaded, vectors));
+	}
+}
+
+TEST_CASE("Vector2DIO vs operator<< and operator>>", "[.benchmark]")
+{
+	const Vector2DArray vectors = make_random_vectors(1'000'000, 665);
+
+	stringstream formatted;
+	for (size_t i = 0; i < vectors.size(); ++i)
+		formatted << vectors[i] << "\n";
+	const std::string formatted_text = formatted.str();
+
+	stringstream bulk;
+	Vector2DIO::write_text(bulk, vectors);
+	const std::string bulk_text = bulk.str();
+
+	stringstream binary(ios::in | ios::out | ios::binary);
+	Vector2DIO::write_binary(binary, vectors);
+	const std::string binary_image = binary.str();
+
+	BENCHMARK("write - operator<<")
+	{
+		stringstream out;
+		for (size_t i = 0; i < vectors.size(); ++i)
+			out << vectors[i] << "\n";
+		return out.tellp();
+	};
+
+	BENCHMARK("write - Vector2DIO::write_text")
+	{
+		stringstream out;
+		Vector2DIO::write_text(out, vectors);
+		return out.tellp();
+	};
+
+	BENCHMARK("write - Vector2DIO::write_binary")
+	{
+		stringstream out(ios::in | ios::out | ios::binary);
+		Vector2DIO::write_binary(out, vectors);
+		return out.tellp();
+	};
+
+	BENCHMARK("read - operator>>")
+	{
+		stringstream in(formatted_text);
+		Vector2DArray loaded;
+		Vector2D vec;
+		// operator>> throws at the end of the stream, so exactly size() vectors are read
+		for (size_t i = 0; i < vectors.size(); ++i)
+		{
+			in >> vec;
+			loaded.push_back(vec);
+		}
+		return loaded.size();
+	};
+
+	BENCHMARK("read - Vector2DIO::read_text")
+	{
+		Vector2DArray loaded;
+		return Vector2DIO::read_text(bulk_text, loaded).count;
+	};
+
+	BENCHMARK("read - Vector2DIO::read_binary")
+	{
+		stringstream in(binary_image, ios::in | ios::binary);
+		Vector2DArray loaded;
+		Vector2DIO::read_binary(in, loaded);
+		return loaded.size();
+	};
+}
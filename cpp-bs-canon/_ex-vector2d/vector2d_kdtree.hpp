@@ -0,0 +1,240 @@
+#ifndef VECTOR2D_KDTREE_HPP
+#define VECTOR2D_KDTREE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "vector2d.hpp"
+#include "vector2d_array.hpp"
+
+namespace Vectors
+{
+	// static k-d tree for nearest neighbour and range queries over a set of points
+	//  - flat layout without node objects or pointers: build reorders the points so that the node of a range
+	//    [first, last) is the median at (first + last) / 2, its children are the ranges on both sides of it;
+	//    splits alternate between x (even depth) and y (odd depth)
+	//  - ranges of up to leaf_size points are leaves scanned linearly
+	//  - coordinates are stored as a structure of arrays, ids give positions of points in the input
+	class KdTree
+	{
+	public:
+		struct Neighbour
+		{
+			size_t id;                 // index of the point in the input of the constructor
+			double squared_distance;
+		};
+
+		static constexpr size_t leaf_size = 8;
+
+	private:
+		std::vector<double> xs_;
+		std::vector<double> ys_;
+		std::vector<uint32_t> ids_;
+
+		struct Point
+		{
+			double x, y;
+			uint32_t id;
+		};
+
+		static void build(std::vector<Point>& points, size_t first, size_t last, size_t depth)
+		{
+			if (last - first <= leaf_size)
+				return;
+
+			const size_t mid = first + (last - first) / 2;
+
+			std::nth_element(points.begin() + first, points.begin() + mid, points.begin() + last,
+				[depth](const Point& lhs, const Point& rhs) { return depth % 2 == 0 ? lhs.x < rhs.x : lhs.y < rhs.y; });
+
+			build(points, first, mid, depth + 1);
+			build(points, mid + 1, last, depth + 1);
+		}
+
+		double squared_distance(size_t index, double x, double y) const
+		{
+			const double dx = xs_[index] - x;
+			const double dy = ys_[index] - y;
+			return dx * dx + dy * dy;
+		}
+
+		// worst neighbour found so far on top
+		struct FartherFirst
+		{
+			bool operator()(const Neighbour& lhs, const Neighbour& rhs) const
+			{
+				return lhs.squared_distance < rhs.squared_distance || (lhs.squared_distance == rhs.squared_distance && lhs.id < rhs.id);
+			}
+		};
+
+		using NeighbourHeap = std::priority_queue<Neighbour, std::vector<Neighbour>, FartherFirst>;
+
+		void offer(NeighbourHeap& heap, size_t k, const Neighbour& candidate) const
+		{
+			if (heap.size() < k)
+				heap.push(candidate);
+			else if (FartherFirst{}(candidate, heap.top()))
+			{
+				heap.pop();
+				heap.push(candidate);
+			}
+		}
+
+		void nearest(size_t first, size_t last, size_t depth, double x, double y, size_t k, NeighbourHeap& heap) const
+		{
+			if (last - first <= leaf_size)
+			{
+				for (size_t i = first; i < last; ++i)
+					offer(heap, k, Neighbour{ ids_[i], squared_distance(i, x, y) });
+				return;
+			}
+
+			const size_t mid = first + (last - first) / 2;
+			offer(heap, k, Neighbour{ ids_[mid], squared_distance(mid, x, y) });
+
+			const double delta = depth % 2 == 0 ? x - xs_[mid] : y - ys_[mid];
+
+			// the side containing the query first - the other side only if it can contain a closer point
+			if (delta < 0)
+				nearest(first, mid, depth + 1, x, y, k, heap);
+			else
+				nearest(mid + 1, last, depth + 1, x, y, k, heap);
+
+			if (heap.size() < k || delta * delta <= heap.top().squared_distance)
+			{
+				if (delta < 0)
+					nearest(mid + 1, last, depth + 1, x, y, k, heap);
+				else
+					nearest(first, mid, depth + 1, x, y, k, heap);
+			}
+		}
+
+		template <typename Visitor>
+		void for_each_in_box(size_t first, size_t last, size_t depth, const Vector2D& min, const Vector2D& max, Visitor& visitor) const
+		{
+			auto inside = [&](size_t i) { return xs_[i] >= min.x() && xs_[i] <= max.x() && ys_[i] >= min.y() && ys_[i] <= max.y(); };
+
+			if (last - first <= leaf_size)
+			{
+				for (size_t i = first; i < last; ++i)
+					if (inside(i))
+						visitor(i);
+				return;
+			}
+
+			const size_t mid = first + (last - first) / 2;
+			const double split = depth % 2 == 0 ? xs_[mid] : ys_[mid];
+			const double low = depth % 2 == 0 ? min.x() : min.y();
+			const double high = depth % 2 == 0 ? max.x() : max.y();
+
+			if (inside(mid))
+				visitor(mid);
+
+			if (low <= split)
+				for_each_in_box(first, mid, depth + 1, min, max, visitor);
+			if (high >= split)
+				for_each_in_box(mid + 1, last, depth + 1, min, max, visitor);
+		}
+
+		static std::vector<size_t> sorted(std::vector<size_t> ids)
+		{
+			std::sort(ids.begin(), ids.end());
+			return ids;
+		}
+
+	public:
+		KdTree() = default;
+
+		explicit KdTree(const Vector2DArray& points)
+		{
+			std::vector<Point> items(points.size());
+			for (size_t i = 0; i < points.size(); ++i)
+				items[i] = Point{ points.xs()[i], points.ys()[i], static_cast<uint32_t>(i) };
+
+			init(items);
+		}
+
+		explicit KdTree(const std::vector<Vector2D>& points)
+		{
+			std::vector<Point> items(points.size());
+			for (size_t i = 0; i < points.size(); ++i)
+				items[i] = Point{ points[i].x(), points[i].y(), static_cast<uint32_t>(i) };
+
+			init(items);
+		}
+
+		size_t size() const
+		{
+			return ids_.size();
+		}
+
+		// k nearest points to query - the closest first (equally distant points by id)
+		std::vector<Neighbour> nearest(const Vector2D& query, size_t k) const
+		{
+			std::vector<Neighbour> result;
+
+			if (k == 0 || ids_.empty())
+				return result;
+
+			NeighbourHeap heap;
+			nearest(0, size(), 0, query.x(), query.y(), k, heap);
+
+			result.resize(heap.size());
+			for (size_t i = result.size(); i-- > 0; heap.pop())
+				result[i] = heap.top();
+
+			return result;
+		}
+
+		// ids of points with min <= point <= max in both coordinates, in ascending order
+		std::vector<size_t> in_box(const Vector2D& min, const Vector2D& max) const
+		{
+			std::vector<size_t> result;
+
+			auto collect = [&](size_t index) { result.push_back(ids_[index]); };
+			if (!ids_.empty())
+				for_each_in_box(0, size(), 0, min, max, collect);
+
+			return sorted(std::move(result));
+		}
+
+		// ids of points within radius from center (boundary included), in ascending order
+		std::vector<size_t> within_radius(const Vector2D& center, double radius) const
+		{
+			std::vector<size_t> result;
+
+			const double squared_radius = radius * radius;
+			auto collect = [&](size_t index) {
+				if (squared_distance(index, center.x(), center.y()) <= squared_radius)
+					result.push_back(ids_[index]);
+			};
+
+			if (!ids_.empty())
+				for_each_in_box(0, size(), 0, center - Vector2D(radius, radius), center + Vector2D(radius, radius), collect);
+
+			return sorted(std::move(result));
+		}
+
+	private:
+		void init(std::vector<Point>& items)
+		{
+			build(items, 0, items.size(), 0);
+
+			xs_.resize(items.size());
+			ys_.resize(items.size());
+			ids_.resize(items.size());
+
+			for (size_t i = 0; i < items.size(); ++i)
+			{
+				xs_[i] = items[i].x;
+				ys_[i] = items[i].y;
+				ids_[i] = items[i].id;
+			}
+		}
+	};
+}
+
+#endif // VECTOR2D_KDTREE_HPP
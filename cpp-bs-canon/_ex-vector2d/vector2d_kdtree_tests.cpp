@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "vector2d_kdtree.hpp"
+#include "vector2d_test_helpers.hpp"
+
+using namespace std;
+
+using namespace Vectors;
+using TestHelpers::make_random_vectors;
+
+namespace
+{
+	double squared_distance(const Vector2D& a, const Vector2D& b)
+	{
+		const Vector2D d = a - b;
+		return d * d;
+	}
+
+	// brute-force references - a scan over all points
+	std::vector<KdTree::Neighbour> scan_nearest(const Vector2DArray& points, const Vector2D& query, size_t k)
+	{
+		std::vector<KdTree::Neighbour> all;
+		all.reserve(points.size());
+		for (size_t i = 0; i < points.size(); ++i)
+			all.push_back(KdTree::Neighbour{ i, squared_distance(points[i], query) });
+
+		const size_t count = std::min(k, all.size());
+		std::partial_sort(all.begin(), all.begin() + count, all.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.squared_distance < rhs.squared_distance || (lhs.squared_distance == rhs.squared_distance && lhs.id < rhs.id);
+		});
+		all.resize(count);
+
+		return all;
+	}
+
+	std::vector<size_t> scan_within_radius(const Vector2DArray& points, const Vector2D& center, double radius)
+	{
+		std::vector<size_t> result;
+		for (size_t i = 0; i < points.size(); ++i)
+			if (squared_distance(points[i], center) <= radius * radius)
+				result.push_back(i);
+		return result;
+	}
+
+	std::vector<size_t> scan_in_box(const Vector2DArray& points, const Vector2D& min, const Vector2D& max)
+	{
+		std::vector<size_t> result;
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			const Vector2D p = points[i];
+			if (p.x() >= min.x() && p.x() <= max.x() && p.y() >= min.y() && p.y() <= max.y())
+				result.push_back(i);
+		}
+		return result;
+	}
+}
+
+TEST_CASE("KdTree")
+{
+	SECTION("empty tree")
+	{
+		KdTree tree;
+
+		REQUIRE(tree.size() == 0);
+		REQUIRE(tree.nearest(Vector2D(1.0, 1.0), 3).empty());
+		REQUIRE(tree.within_radius(Vector2D(1.0, 1.0), 10.0).empty());
+	}
+
+	SECTION("nearest of a few points")
+	{
+		KdTree tree(std::vector<Vector2D>{ Vector2D(0.0, 0.0), Vector2D(10.0, 0.0), Vector2D(0.0, 5.0), Vector2D(3.0, 3.0) });
+
+		auto neighbours = tree.nearest(Vector2D(4.0, 4.0), 2);
+
+		REQUIRE(neighbours.size() == 2);
+		REQUIRE(neighbours[0].id == 3);
+		REQUIRE(neighbours[0].squared_distance == Approx(2.0));
+		REQUIRE(neighbours[1].id == 2);
+	}
+
+	SECTION("k larger than the number of points returns all points")
+	{
+		KdTree tree(std::vector<Vector2D>{ Vector2D(1.0, 0.0), Vector2D(2.0, 0.0) });
+
+		REQUIRE(tree.nearest(Vector2D(0.0, 0.0), 5).size() == 2);
+	}
+
+	SECTION("duplicated points are all reported")
+	{
+		KdTree tree(std::vector<Vector2D>(20, Vector2D(1.0, 1.0)));
+
+		REQUIRE(tree.within_radius(Vector2D(1.0, 1.0), 0.0).size() == 20);
+		REQUIRE(tree.in_box(Vector2D(1.0, 1.0), Vector2D(1.0, 1.0)).size() == 20);
+	}
+}
+
+TEST_CASE("KdTree gives the same results as a brute-force scan")
+{
+	// sizes cover a single leaf and trees several levels deep
+	for (size_t size : { 1u, 8u, 9u, 100u, 5000u })
+	{
+		DYNAMIC_SECTION("size " << size)
+		{
+			const Vector2DArray points = make_random_vectors(size, 42);
+			const KdTree tree(points);
+			const Vector2DArray queries = make_random_vectors(50, 7);
+
+			REQUIRE(tree.size() == size);
+
+			for (size_t q = 0; q < queries.size(); ++q)
+			{
+				const Vector2D query = queries[q];
+
+				auto expected_nearest = scan_nearest(points, query, 10);
+				auto nearest = tree.nearest(query, 10);
+				REQUIRE(nearest.size() == expected_nearest.size());
+				for (size_t i = 0; i < nearest.size(); ++i)
+				{
+					REQUIRE(nearest[i].id == expected_nearest[i].id);
+					REQUIRE(nearest[i].squared_distance == expected_nearest[i].squared_distance);
+				}
+
+				REQUIRE(tree.within_radius(query, 25.0) == scan_within_radius(points, query, 25.0));
+				REQUIRE(tree.in_box(query, query + Vector2D(30.0, 15.0)) == scan_in_box(points, query, query + Vector2D(30.0, 15.0)));
+			}
+		}
+	}
+}
+
+TEST_CASE("KdTree vs brute-force scan", "[.benchmark]")
+{
+	const Vector2DArray queries = make_random_vectors(100, 7);
+
+	for (size_t size : { 10'000u, 100'000u, 1'000'000u, 10'000'000u })
+	{
+		DYNAMIC_SECTION("size " << size)
+		{
+			const Vector2DArray points = make_random_vectors(size, 42);
+			const KdTree tree(points);
+
+			// radius chosen so that about 10 points are found independently of size
+			const double radius = 200.0 * std::sqrt(10.0 / (3.14159 * size));
+
+			BENCHMARK("build")
+			{
+				return KdTree(points).size();
+			};
+
+			BENCHMARK("10-NN - scan")
+			{
+				size_t sum = 0;
+				for (size_t q = 0; q < queries.size(); ++q)
+					sum += scan_nearest(points, queries[q], 10).front().id;
+				return sum;
+			};
+
+			BENCHMARK("10-NN - KdTree")
+			{
+				size_t sum = 0;
+				for (size_t q = 0; q < queries.size(); ++q)
+					sum += tree.nearest(queries[q], 10).front().id;
+				return sum;
+			};
+
+			BENCHMARK("radius - scan")
+			{
+				size_t count = 0;
+				for (size_t q = 0; q < queries.size(); ++q)
+					count += scan_within_radius(points, queries[q], radius).size();
+				return count;
+			};
+
+			BENCHMARK("radius - KdTree")
+			{
+				size_t count = 0;
+				for (size_t q = 0; q < queries.size(); ++q)
+					count += tree.within_radius(queries[q], radius).size();
+				return count;
+			};
+		}
+	}
+}
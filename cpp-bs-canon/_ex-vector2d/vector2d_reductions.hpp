@@ -0,0 +1,219 @@
+#ifndef VECTOR2D_REDUCTIONS_HPP
+#define VECTOR2D_REDUCTIONS_HPP
+
+#include <algorithm>
+#include <execution>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "vector2d.hpp"
+
+namespace Vectors
+{
+	// aggregates over ranges of Vector2D
+	//  - every reduction has a serial reference f(first, last) - a left fold in the order of the range
+	//  - and a parallel version f(policy, first, last) for std::execution policies (random-access iterators only)
+	//
+	// parallel versions split the range into blocks of block_size elements, reduce the blocks concurrently
+	// and fold the block results in order; blocks don't depend on the number of threads, so a parallel
+	// result is bit-identical between runs and machines for the same input
+	// it differs from the serial reference only by rounding - for sums of n terms t_i:
+	//     |parallel - serial| <= 2 * n * epsilon * sum(|t_i|)
+	// bounding boxes are exact (min and max don't round)
+	namespace Reductions
+	{
+		constexpr size_t block_size = 4096;
+
+		struct BoundingBox
+		{
+			Vector2D min{ std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity() };
+			Vector2D max{ -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+
+			// box of an empty range
+			bool empty() const
+			{
+				return min.x() > max.x();
+			}
+
+			void extend(const Vector2D& v)
+			{
+				min = Vector2D(std::min(min.x(), v.x()), std::min(min.y(), v.y()));
+				max = Vector2D(std::max(max.x(), v.x()), std::max(max.y(), v.y()));
+			}
+
+			// an empty box is the identity - its infinite corners lose every min/max
+			void extend(const BoundingBox& other)
+			{
+				min = Vector2D(std::min(min.x(), other.min.x()), std::min(min.y(), other.min.y()));
+				max = Vector2D(std::max(max.x(), other.max.x()), std::max(max.y(), other.max.y()));
+			}
+		};
+
+		namespace Detail
+		{
+			template <typename Policy, typename Result = void>
+			using EnableIfPolicy = std::enable_if_t<std::is_execution_policy_v<std::decay_t<Policy>>, Result>;
+
+			template <typename Iterator>
+			constexpr void require_random_access()
+			{
+				static_assert(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>,
+					"parallel reductions require random-access iterators");
+			}
+
+			// fold of element(i) for i in [first, last)
+			template <typename T, typename Element, typename Combine>
+			T fold(size_t first, size_t last, T init, Element element, Combine combine)
+			{
+				for (size_t i = first; i < last; ++i)
+					init = combine(init, element(i));
+				return init;
+			}
+
+			template <typename Policy, typename T, typename Element, typename Combine>
+			T block_reduce(Policy&& policy, size_t size, T init, Element element, Combine combine)
+			{
+				const size_t block_count = (size + block_size - 1) / block_size;
+
+				std::vector<size_t> blocks(block_count);
+				std::iota(blocks.begin(), blocks.end(), size_t{ 0 });
+
+				std::vector<T> partials(block_count);
+				std::transform(std::forward<Policy>(policy), blocks.begin(), blocks.end(), partials.begin(),
+					[=](size_t block) {
+						const size_t first = block * block_size;
+						return fold(first, std::min(first + block_size, size), T{}, element, combine);
+					});
+
+				for (const auto& partial : partials)
+					init = combine(init, partial);
+
+				return init;
+			}
+
+			struct Merge
+			{
+				BoundingBox operator()(BoundingBox box, const BoundingBox& other) const
+				{
+					box.extend(other);
+					return box;
+				}
+			};
+
+			inline BoundingBox box_of(const Vector2D& v)
+			{
+				return BoundingBox{ v, v };
+			}
+
+			inline void check_not_empty(size_t size)
+			{
+				if (size == 0)
+					throw std::invalid_argument("Centroid of an empty range");
+			}
+		}
+
+		//////////////////////////////////////////////////////
+		// sum
+
+		template <typename Iterator>
+		Vector2D sum(Iterator first, Iterator last)
+		{
+			return std::accumulate(first, last, Vector2D{}, [](const Vector2D& acc, const Vector2D& v) { return acc + v; });
+		}
+
+		template <typename Policy, typename Iterator>
+		Detail::EnableIfPolicy<Policy, Vector2D> sum(Policy&& policy, Iterator first, Iterator last)
+		{
+			Detail::require_random_access<Iterator>();
+
+			return Detail::block_reduce(std::forward<Policy>(policy), static_cast<size_t>(std::distance(first, last)), Vector2D{},
+				[first](size_t i) { return Vector2D(first[i]); }, std::plus<>{});
+		}
+
+		//////////////////////////////////////////////////////
+		// centroid - throws std::invalid_argument for an empty range
+
+		template <typename Iterator>
+		Vector2D centroid(Iterator first, Iterator last)
+		{
+			const size_t size = static_cast<size_t>(std::distance(first, last));
+			Detail::check_not_empty(size);
+
+			return sum(first, last) * (1.0 / size);
+		}
+
+		template <typename Policy, typename Iterator>
+		Detail::EnableIfPolicy<Policy, Vector2D> centroid(Policy&& policy, Iterator first, Iterator last)
+		{
+			const size_t size = static_cast<size_t>(std::distance(first, last));
+			Detail::check_not_empty(size);
+
+			return sum(std::forward<Policy>(policy), first, last) * (1.0 / size);
+		}
+
+		//////////////////////////////////////////////////////
+		// axis-aligned bounding box - empty() for an empty range
+
+		template <typename Iterator>
+		BoundingBox bounding_box(Iterator first, Iterator last)
+		{
+			BoundingBox box;
+			for (; first != last; ++first)
+				box.extend(*first);
+			return box;
+		}
+
+		template <typename Policy, typename Iterator>
+		Detail::EnableIfPolicy<Policy, BoundingBox> bounding_box(Policy&& policy, Iterator first, Iterator last)
+		{
+			Detail::require_random_access<Iterator>();
+
+			return Detail::block_reduce(std::forward<Policy>(policy), static_cast<size_t>(std::distance(first, last)), BoundingBox{},
+				[first](size_t i) { return Detail::box_of(first[i]); }, Detail::Merge{});
+		}
+
+		//////////////////////////////////////////////////////
+		// sum of lengths
+
+		template <typename Iterator>
+		double total_length(Iterator first, Iterator last)
+		{
+			return std::accumulate(first, last, 0.0, [](double acc, const Vector2D& v) { return acc + v.length(); });
+		}
+
+		template <typename Policy, typename Iterator>
+		Detail::EnableIfPolicy<Policy, double> total_length(Policy&& policy, Iterator first, Iterator last)
+		{
+			Detail::require_random_access<Iterator>();
+
+			return Detail::block_reduce(std::forward<Policy>(policy), static_cast<size_t>(std::distance(first, last)), 0.0,
+				[first](size_t i) { return first[i].length(); }, std::plus<>{});
+		}
+
+		//////////////////////////////////////////////////////
+		// sum of dot products of corresponding vectors of [first1, last1) and [first2, ...)
+
+		template <typename Iterator1, typename Iterator2>
+		double sum_of_dots(Iterator1 first1, Iterator1 last1, Iterator2 first2)
+		{
+			return std::inner_product(first1, last1, first2, 0.0, std::plus<>{}, [](const Vector2D& a, const Vector2D& b) { return a * b; });
+		}
+
+		template <typename Policy, typename Iterator1, typename Iterator2>
+		Detail::EnableIfPolicy<Policy, double> sum_of_dots(Policy&& policy, Iterator1 first1, Iterator1 last1, Iterator2 first2)
+		{
+			Detail::require_random_access<Iterator1>();
+			Detail::require_random_access<Iterator2>();
+
+			return Detail::block_reduce(std::forward<Policy>(policy), static_cast<size_t>(std::distance(first1, last1)), 0.0,
+				[first1, first2](size_t i) { return first1[i] * first2[i]; }, std::plus<>{});
+		}
+	}
+}
+
+#endif // VECTOR2D_REDUCTIONS_HPP
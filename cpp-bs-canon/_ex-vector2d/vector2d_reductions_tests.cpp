@@ -0,0 +1,186 @@
+#include <cmath>
+#include <execution>
+#include <limits>
+#include <list>
+#include <vector>
+
+#include "vector2d_reductions.hpp"
+#include "vector2d_test_helpers.hpp"
+
+using namespace std;
+
+using namespace Vectors;
+using TestHelpers::make_random_vectors;
+
+namespace
+{
+	// documented bound: 2 * n * epsilon * sum of absolute values of the terms
+	double tolerance(size_t size, double sum_of_abs)
+	{
+		return 2.0 * size * std::numeric_limits<double>::epsilon() * sum_of_abs;
+	}
+}
+
+TEST_CASE("reductions")
+{
+	const std::vector<Vector2D> vectors = { Vector2D(1.0, 2.0), Vector2D(-3.0, 4.0), Vector2D(5.0, -6.0) };
+
+	SECTION("centroid")
+	{
+		REQUIRE(Reductions::centroid(vectors.begin(), vectors.end()) == Vector2D(1.0, 0.0));
+		REQUIRE(Reductions::centroid(std::execution::par_unseq, vectors.begin(), vectors.end()) == Vector2D(1.0, 0.0));
+	}
+
+	SECTION("centroid of an empty range throws")
+	{
+		std::vector<Vector2D> empty;
+
+		REQUIRE_THROWS_AS(Reductions::centroid(empty.begin(), empty.end()), std::invalid_argument);
+		REQUIRE_THROWS_AS(Reductions::centroid(std::execution::par_unseq, empty.begin(), empty.end()), std::invalid_argument);
+	}
+
+	SECTION("bounding box")
+	{
+		auto box = Reductions::bounding_box(std::execution::par_unseq, vectors.begin(), vectors.end());
+
+		REQUIRE(box.min == Vector2D(-3.0, -6.0));
+		REQUIRE(box.max == Vector2D(5.0, 4.0));
+	}
+
+	SECTION("bounding box of an empty range is empty")
+	{
+		std::vector<Vector2D> empty;
+
+		REQUIRE(Reductions::bounding_box(empty.begin(), empty.end()).empty());
+		REQUIRE(Reductions::bounding_box(std::execution::par_unseq, empty.begin(), empty.end()).empty());
+	}
+
+	SECTION("total length")
+	{
+		std::vector<Vector2D> vs = { Vector2D(3.0, 4.0), Vector2D(0.0, -2.0) };
+
+		REQUIRE(Reductions::total_length(vs.begin(), vs.end()) == 7.0);
+		REQUIRE(Reductions::total_length(std::execution::par_unseq, vs.begin(), vs.end()) == 7.0);
+	}
+
+	SECTION("sum of dot products")
+	{
+		std::vector<Vector2D> others = { Vector2D(1.0, 1.0), Vector2D(1.0, 1.0), Vector2D(2.0, 0.0) };
+
+		REQUIRE(Reductions::sum_of_dots(vectors.begin(), vectors.end(), others.begin()) == 14.0);
+		REQUIRE(Reductions::sum_of_dots(std::execution::par_unseq, vectors.begin(), vectors.end(), others.begin()) == 14.0);
+	}
+
+	SECTION("serial versions accept forward iterators")
+	{
+		std::list<Vector2D> lst(vectors.begin(), vectors.end());
+
+		REQUIRE(Reductions::centroid(lst.begin(), lst.end()) == Vector2D(1.0, 0.0));
+		REQUIRE(Reductions::bounding_box(lst.begin(), lst.end()).max == Vector2D(5.0, 4.0));
+	}
+}
+
+TEST_CASE("parallel reductions match the serial reference")
+{
+	// sizes cover a part of one block, exactly one block and many blocks with a remainder
+	for (size_t size : { 1u, 100u, 4096u, 100'003u })
+	{
+		DYNAMIC_SECTION("size " << size)
+		{
+			const auto vectors = make_random_vectors<std::vector<Vector2D>>(size, 42);
+			const auto others = make_random_vectors<std::vector<Vector2D>>(size, 7);
+
+			double sum_of_abs_x = 0.0, sum_of_abs_y = 0.0, sum_of_lengths = 0.0, sum_of_abs_dots = 0.0;
+			for (size_t i = 0; i < size; ++i)
+			{
+				sum_of_abs_x += std::abs(vectors[i].x());
+				sum_of_abs_y += std::abs(vectors[i].y());
+				sum_of_lengths += vectors[i].length();
+				sum_of_abs_dots += std::abs(vectors[i] * others[i]);
+			}
+
+			const auto sum = Reductions::sum(vectors.begin(), vectors.end());
+			const auto par_sum = Reductions::sum(std::execution::par_unseq, vectors.begin(), vectors.end());
+			REQUIRE(std::abs(par_sum.x() - sum.x()) <= tolerance(size, sum_of_abs_x));
+			REQUIRE(std::abs(par_sum.y() - sum.y()) <= tolerance(size, sum_of_abs_y));
+
+			const auto centroid = Reductions::centroid(vectors.begin(), vectors.end());
+			const auto par_centroid = Reductions::centroid(std::execution::par_unseq, vectors.begin(), vectors.end());
+			REQUIRE(std::abs(par_centroid.x() - centroid.x()) <= tolerance(size, sum_of_abs_x) / size);
+			REQUIRE(std::abs(par_centroid.y() - centroid.y()) <= tolerance(size, sum_of_abs_y) / size);
+
+			const auto box = Reductions::bounding_box(vectors.begin(), vectors.end());
+			const auto par_box = Reductions::bounding_box(std::execution::par_unseq, vectors.begin(), vectors.end());
+			REQUIRE(par_box.min == box.min);
+			REQUIRE(par_box.max == box.max);
+
+			const double length = Reductions::total_length(vectors.begin(), vectors.end());
+			const double par_length = Reductions::total_length(std::execution::par_unseq, vectors.begin(), vectors.end());
+			REQUIRE(std::abs(par_length - length) <= tolerance(size, sum_of_lengths));
+
+			const double dots = Reductions::sum_of_dots(vectors.begin(), vectors.end(), others.begin());
+			const double par_dots = Reductions::sum_of_dots(std::execution::par_unseq, vectors.begin(), vectors.end(), others.begin());
+			REQUIRE(std::abs(par_dots - dots) <= tolerance(size, sum_of_abs_dots));
+		}
+	}
+
+	SECTION("parallel results don't depend on the policy or on scheduling")
+	{
+		const auto vectors = make_random_vectors<std::vector<Vector2D>>(1'000'000, 665);
+
+		const double seq_length = Reductions::total_length(std::execution::seq, vectors.begin(), vectors.end());
+		const auto seq_centroid = Reductions::centroid(std::execution::seq, vectors.begin(), vectors.end());
+
+		for (int run = 0; run < 5; ++run)
+		{
+			REQUIRE(Reductions::total_length(std::execution::par_unseq, vectors.begin(), vectors.end()) == seq_length);
+			REQUIRE(Reductions::centroid(std::execution::par, vectors.begin(), vectors.end()) == seq_centroid);
+		}
+	}
+}
+
+TEST_CASE("parallel reductions vs serial reference", "[.benchmark]")
+{
+	const auto vectors = make_random_vectors<std::vector<Vector2D>>(10'000'000, 665);
+	const auto others = make_random_vectors<std::vector<Vector2D>>(10'000'000, 7);
+
+	BENCHMARK("centroid - serial")
+	{
+		return Reductions::centroid(vectors.begin(), vectors.end()).x();
+	};
+
+	BENCHMARK("centroid - par_unseq")
+	{
+		return Reductions::centroid(std::execution::par_unseq, vectors.begin(), vectors.end()).x();
+	};
+
+	BENCHMARK("bounding box - serial")
+	{
+		return Reductions::bounding_box(vectors.begin(), vectors.end()).max.x();
+	};
+
+	BENCHMARK("bounding box - par_unseq")
+	{
+		return Reductions::bounding_box(std::execution::par_unseq, vectors.begin(), vectors.end()).max.x();
+	};
+
+	BENCHMARK("total length - serial")
+	{
+		return Reductions::total_length(vectors.begin(), vectors.end());
+	};
+
+	BENCHMARK("total length - par_unseq")
+	{
+		return Reductions::total_length(std::execution::par_unseq, vectors.begin(), vectors.end());
+	};
+
+	BENCHMARK("sum of dots - serial")
+	{
+		return Reductions::sum_of_dots(vectors.begin(), vectors.end(), others.begin());
+	};
+
+	BENCHMARK("sum of dots - par_unseq")
+	{
+		return Reductions::sum_of_dots(std::execution::par_unseq, vectors.begin(), vectors.end(), others.begin());
+	};
+}
@@ -0,0 +1,171 @@
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "vector2d.hpp"
+#include "vector2d_fixed.hpp"
+#include "vector2d_test_helpers.hpp"
+
+using namespace std;
+
+using namespace Vectors;
+
+namespace
+{
+	// coordinates in [-10, 10) keep errors of Fixed products within the margins checked below
+	template <typename T>
+	std::vector<BasicVector2D<T>> make_random_vectors(size_t size, unsigned seed)
+	{
+		return TestHelpers::make_random_vectors<std::vector<BasicVector2D<T>>>(size, seed, 10.0);
+	}
+}
+
+static_assert(sizeof(Vector2D) == 2 * sizeof(double));
+static_assert(sizeof(Vector2Df) == 2 * sizeof(float));
+static_assert(sizeof(Vector2DFixed) == 2 * sizeof(int32_t));
+
+static_assert(Vector2Df::unit_x() * Vector2Df::unit_y() == 0.0f);
+static_assert(Vector2DFixed::unit_x() + Vector2DFixed::unit_y() == Vector2DFixed(Fixed(1.0), Fixed(1.0)));
+
+TEST_CASE("Fixed")
+{
+	SECTION("conversions round to the nearest value")
+	{
+		REQUIRE(Fixed(1.5).raw() == 3 * Fixed::one / 2);
+		REQUIRE(Fixed(-0.25).raw() == -Fixed::one / 4);
+		REQUIRE(static_cast<double>(Fixed(2.75)) == 2.75);
+		REQUIRE(Fixed(1.0 / 3.0).raw() == 21845);
+	}
+
+	SECTION("values out of range saturate")
+	{
+		static_assert(Fixed(1e9).raw() == std::numeric_limits<int32_t>::max());
+		static_assert(Fixed(-1e9).raw() == std::numeric_limits<int32_t>::min());
+
+		REQUIRE(Fixed(32768.0).raw() == std::numeric_limits<int32_t>::max());
+		REQUIRE(Fixed(-32768.0).raw() == std::numeric_limits<int32_t>::min());
+		REQUIRE(Fixed(std::numeric_limits<double>::infinity()).raw() == std::numeric_limits<int32_t>::max());
+		REQUIRE(Fixed(-std::numeric_limits<double>::infinity()).raw() == std::numeric_limits<int32_t>::min());
+		REQUIRE(Fixed(std::numeric_limits<double>::quiet_NaN()).raw() == 0);
+		REQUIRE(Fixed(32767.5).raw() == 32767 * Fixed::one + Fixed::one / 2);
+	}
+
+	SECTION("arithmetic")
+	{
+		REQUIRE(Fixed(1.5) + Fixed(2.25) == Fixed(3.75));
+		REQUIRE(Fixed(1.5) - Fixed(2.25) == Fixed(-0.75));
+		REQUIRE(Fixed(1.5) * Fixed(-2.5) == Fixed(-3.75));
+		REQUIRE(-Fixed(1.5) == Fixed(-1.5));
+		REQUIRE(Fixed(0.5) < Fixed(0.75));
+	}
+}
+
+TEST_CASE("BasicVector2D")
+{
+	SECTION("float")
+	{
+		const Vector2Df v1(1.0f, 2.0f);
+		const Vector2Df v2(2.0f, 0.5f);
+
+		REQUIRE(v1 + v2 == Vector2Df(3.0f, 2.5f));
+		REQUIRE(v1 * v2 == 3.0f);
+		REQUIRE(2.0f * v1 == Vector2Df(2.0f, 4.0f));
+		REQUIRE(Vector2Df(3.0f, 4.0f).length() == 5.0f);
+	}
+
+	SECTION("fixed point")
+	{
+		const Vector2DFixed v1(Fixed(1.0), Fixed(2.0));
+		const Vector2DFixed v2(Fixed(2.0), Fixed(0.5));
+
+		REQUIRE(v1 - v2 == Vector2DFixed(Fixed(-1.0), Fixed(1.5)));
+		REQUIRE(v1 * v2 == Fixed(3.0));
+		REQUIRE(v1 * Fixed(0.5) == Vector2DFixed(Fixed(0.5), Fixed(1.0)));
+		REQUIRE(Vector2DFixed(Fixed(3.0), Fixed(4.0)).length() == Fixed(5.0));
+	}
+
+	SECTION("fixed point length doesn't overflow for large coordinates")
+	{
+		REQUIRE(Vector2DFixed(Fixed(3000.0), Fixed(4000.0)).length() == Fixed(5000.0));
+	}
+
+	SECTION("fixed point length out of range saturates")
+	{
+		REQUIRE(Vector2DFixed(Fixed(30000.0), Fixed(30000.0)).length() == Fixed::max());
+		REQUIRE(Vector2DFixed(Fixed(-32768.0), Fixed(-32768.0)).length() == Fixed::max());
+		REQUIRE(Vector2DFixed(Fixed(32767.0), Fixed(0.0)).length() == Fixed(32767.0));
+	}
+
+	SECTION("stream operators")
+	{
+		Vector2DFixed v;
+		stringstream ss("[1.5, -2.25]");
+		ss >> v;
+
+		REQUIRE(v == Vector2DFixed(Fixed(1.5), Fixed(-2.25)));
+
+		stringstream out;
+		out << Vector2Df(1.0f, 2.0f);
+		REQUIRE(out.str() == "[1.0, 2.0]");
+	}
+
+	SECTION("results of float and fixed point are close to double")
+	{
+		const auto vectors = make_random_vectors<double>(1000, 42);
+
+		for (size_t i = 1; i < vectors.size(); ++i)
+		{
+			const Vector2D a = vectors[i - 1], b = vectors[i];
+			const Vector2Df af(static_cast<float>(a.x()), static_cast<float>(a.y()));
+			const Vector2Df bf(static_cast<float>(b.x()), static_cast<float>(b.y()));
+			const Vector2DFixed ax(Fixed(a.x()), Fixed(a.y()));
+			const Vector2DFixed bx(Fixed(b.x()), Fixed(b.y()));
+
+			REQUIRE((af * bf) == Approx(a * b).margin(1e-4));
+			REQUIRE(static_cast<double>(ax * bx) == Approx(a * b).margin(1e-3));
+			REQUIRE(static_cast<double>((ax + bx).length()) == Approx((a + b).length()).margin(1e-4));
+		}
+	}
+}
+
+namespace
+{
+	template <typename T>
+	void benchmark_bulk_operations(const char* add_name, const char* scale_name, const char* dot_name)
+	{
+		const size_t size = 10'000'000;
+		const auto a = make_random_vectors<T>(size, 665);
+		const auto b = make_random_vectors<T>(size, 667);
+		std::vector<BasicVector2D<T>> result(size);
+
+		BENCHMARK(add_name)
+		{
+			for (size_t i = 0; i < size; ++i)
+				result[i] = a[i] + b[i];
+			return result[size / 2].x();
+		};
+
+		BENCHMARK(scale_name)
+		{
+			const T factor(0.5);
+			for (size_t i = 0; i < size; ++i)
+				result[i] = a[i] * factor;
+			return result[size / 2].x();
+		};
+
+		BENCHMARK(dot_name)
+		{
+			T sum{};
+			for (size_t i = 0; i < size; ++i)
+				sum = sum + a[i] * b[i];
+			return sum;
+		};
+	}
+}
+
+TEST_CASE("BasicVector2D bulk operations - double vs float vs fixed point", "[.benchmark]")
+{
+	benchmark_bulk_operations<double>("add - double", "scale - double", "sum of dots - double");
+	benchmark_bulk_operations<float>("add - float", "scale - float", "sum of dots - float");
+	benchmark_bulk_operations<Fixed>("add - Fixed", "scale - Fixed", "sum of dots - Fixed");
+}
@@ -0,0 +1,108 @@
+#ifndef VECTOR2D_TABLES_HPP
+#define VECTOR2D_TABLES_HPP
+
+#include <array>
+#include <cstddef>
+
+#include "vector2d.hpp"
+
+namespace Vectors
+{
+	// tables of vectors computed at compile time
+	//  - constexpr tables are constant-initialized: they are stored in the read-only data of the binary,
+	//    no code runs at startup to fill them
+	namespace Tables
+	{
+		constexpr double pi = 3.141592653589793238462643383279502884;
+
+		namespace Detail
+		{
+			// Taylor series for |x| <= pi / 4 - the terms drop below 1e-17 after x^17
+			constexpr double sin_reduced(double x)
+			{
+				const double x2 = x * x;
+				double term = x;
+				double sum = x;
+
+				for (int n = 2; n <= 18; n += 2)
+				{
+					term *= -x2 / (n * (n + 1));
+					sum += term;
+				}
+
+				return sum;
+			}
+
+			constexpr double cos_reduced(double x)
+			{
+				const double x2 = x * x;
+				double term = 1.0;
+				double sum = 1.0;
+
+				for (int n = 1; n <= 17; n += 2)
+				{
+					term *= -x2 / (n * (n + 1));
+					sum += term;
+				}
+
+				return sum;
+			}
+		}
+
+		// cos and sin of angle (in radians) usable in constant expressions (std::cos and std::sin are not constexpr)
+		//  - the angle is reduced to one octant, the error is within a few ulps of std::cos/std::sin
+		constexpr Vector2D cos_sin(double angle)
+		{
+			const double quarter = pi / 2;
+
+			const double turns = angle / quarter;
+			const long long quadrant = static_cast<long long>(turns >= 0 ? turns + 0.5 : turns - 0.5);
+			const double x = angle - static_cast<double>(quadrant) * quarter;
+
+			const double c = Detail::cos_reduced(x);
+			const double s = Detail::sin_reduced(x);
+
+			switch (((quadrant % 4) + 4) % 4)
+			{
+			case 0:
+				return Vector2D(c, s);
+			case 1:
+				return Vector2D(-s, c);
+			case 2:
+				return Vector2D(-c, -s);
+			default:
+				return Vector2D(s, -c);
+			}
+		}
+
+		// table[i] = f(i)
+		template <size_t N, typename F>
+		constexpr std::array<Vector2D, N> make_table(F f)
+		{
+			std::array<Vector2D, N> table;
+
+			for (size_t i = 0; i < N; ++i)
+				table[i] = f(i);
+
+			return table;
+		}
+
+		// N points evenly spaced on the unit circle, counterclockwise from unit_x
+		template <size_t N>
+		constexpr std::array<Vector2D, N> make_unit_circle()
+		{
+			return make_table<N>([](size_t i) { return cos_sin(2 * pi * static_cast<double>(i) / static_cast<double>(N)); });
+		}
+
+		template <size_t N>
+		inline constexpr std::array<Vector2D, N> unit_circle = make_unit_circle<N>();
+
+		// rotation of v by the angle given by its cos and sin (e.g. an entry of unit_circle)
+		constexpr Vector2D rotate(const Vector2D& v, const Vector2D& cos_sin)
+		{
+			return Vector2D(v.x() * cos_sin.x() - v.y() * cos_sin.y(), v.x() * cos_sin.y() + v.y() * cos_sin.x());
+		}
+	}
+}
+
+#endif // VECTOR2D_TABLES_HPP
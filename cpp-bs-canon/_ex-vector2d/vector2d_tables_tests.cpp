@@ -0,0 +1,81 @@
+#include <cmath>
+
+#include "catch.hpp"
+#include "vector2d_tables.hpp"
+
+using namespace std;
+
+using namespace Vectors;
+
+namespace
+{
+	// whole arithmetic of Vector2D works in constant expressions
+	constexpr Vector2D v1(1.0, 2.0);
+	constexpr Vector2D v2(3.0, 4.0);
+
+	static_assert(v1.x() == 1.0 && v1.y() == 2.0);
+	static_assert(v1 + v2 == Vector2D(4.0, 6.0));
+	static_assert(v2 - v1 == Vector2D(2.0, 2.0));
+	static_assert(-v1 == Vector2D(-1.0, -2.0));
+	static_assert(v1 * 2.0 == 2.0 * v1);
+	static_assert(v1 * v2 == 11.0);
+	static_assert(v1 != v2);
+	static_assert(-(v1 + v2 * (v2 * (-v1 * 4.0))) == Vector2D(131.0, 174.0));
+	static_assert(Vector2D::unit_x() * Vector2D::unit_y() == 0.0);
+
+	constexpr Vector2D scaled(Vector2D v, double value)
+	{
+		v *= value;
+		return v;
+	}
+
+	static_assert(scaled(v1, 3.0) == Vector2D(3.0, 6.0));
+
+	static_assert(Tables::unit_circle<4>[0] == Vector2D::unit_x());
+	static_assert(Tables::unit_circle<4>[1] == Vector2D::unit_y());
+	static_assert(Tables::unit_circle<4>[2] == -Vector2D::unit_x());
+	static_assert(Tables::unit_circle<4>[3] == -Vector2D::unit_y());
+}
+
+TEST_CASE("compile-time tables")
+{
+	SECTION("cos_sin matches std::cos and std::sin")
+	{
+		for (double angle = -20.0; angle <= 20.0; angle += 0.01)
+		{
+			const Vector2D cs = Tables::cos_sin(angle);
+			REQUIRE(cs.x() == Approx(std::cos(angle)).margin(1e-14));
+			REQUIRE(cs.y() == Approx(std::sin(angle)).margin(1e-14));
+		}
+	}
+
+	SECTION("unit circle")
+	{
+		constexpr size_t n = 360;
+		constexpr auto& circle = Tables::unit_circle<n>;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double angle = 2 * Tables::pi * i / n;
+			REQUIRE(circle[i].x() == Approx(std::cos(angle)).margin(1e-15));
+			REQUIRE(circle[i].y() == Approx(std::sin(angle)).margin(1e-15));
+		}
+	}
+
+	SECTION("rotation with table entries")
+	{
+		constexpr auto& circle = Tables::unit_circle<8>;
+
+		Vector2D v = Vector2D::unit_x();
+		for (size_t i = 0; i < circle.size(); ++i)
+		{
+			REQUIRE(v.x() == Approx(circle[i].x()).margin(1e-15));
+			REQUIRE(v.y() == Approx(circle[i].y()).margin(1e-15));
+
+			v = Tables::rotate(v, circle[1]);
+		}
+
+		REQUIRE(v.x() == Approx(1.0));
+		REQUIRE(v.y() == Approx(0.0).margin(1e-15));
+	}
+}
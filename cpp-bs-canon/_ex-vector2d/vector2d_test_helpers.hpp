@@ -0,0 +1,45 @@
+#ifndef VECTOR2D_TEST_HELPERS_HPP
+#define VECTOR2D_TEST_HELPERS_HPP
+
+#include <random>
+#include <type_traits>
+#include <utility>
+
+// BENCHMARK is available only in files compiled with CATCH_CONFIG_ENABLE_BENCHMARKING defined before catch.hpp -
+// test files include this header instead of catch.hpp, so the setting lives in one place (as in catch_main.cpp)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "vector2d.hpp"
+#include "vector2d_array.hpp"
+
+// test data shared by the test files - the same seed always gives the same vectors
+namespace TestHelpers
+{
+	// size vectors with coordinates uniformly distributed in [-range, range)
+	//  - Container is Vector2DArray or a standard container of vectors, e.g. std::vector<Vector2Df>
+	//  - coordinates are drawn as doubles and converted to the scalar type of the vectors
+	template <typename Container = Vectors::Vector2DArray>
+	Container make_random_vectors(size_t size, unsigned seed, double range = 100.0)
+	{
+		using Vector = std::decay_t<decltype(std::declval<const Container&>()[0])>;
+		using Scalar = typename Vector::value_type;
+
+		std::mt19937 rnd(seed);
+		std::uniform_real_distribution<double> coord(-range, range);
+
+		Container vectors;
+		vectors.reserve(size);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			const double x = coord(rnd);
+			const double y = coord(rnd);
+			vectors.push_back(Vector(static_cast<Scalar>(x), static_cast<Scalar>(y)));
+		}
+
+		return vectors;
+	}
+}
+
+#endif // VECTOR2D_TEST_HELPERS_HPP
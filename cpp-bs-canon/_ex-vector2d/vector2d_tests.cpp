@@ -6,142 +6,10 @@
 #include <string>
 
 #include "catch.hpp"
+#include "vector2d.hpp"
 
 using namespace std;
 
-namespace Vectors
-{
-	class Vector2D
-	{
-		double x_;
-		double y_;
-
-		static const Vector2D unit_x_;
-		static const Vector2D unit_y_;
-
-	public:
-		explicit Vector2D(double x = 0.0, double y = 0.0)
-			: x_(x), y_(y)
-		{
-		}
-
-		double x() const { return x_; }
-
-		double y() const { return y_; }
-
-		double length() const { return sqrt(x_ * x_ + y_ * y_); }
-		
-		static const Vector2D& unit_x()
-		{
-			return unit_x_;
-
-		}
-
-		static const Vector2D& unit_y()
-		{
-			return unit_y_;
-
-		}
-
-		Vector2D operator*(double value) const
-		{
-			return Vector2D(x() * value, y() * value);
-		}
-
-		//Vector2D& operator*=(double value)
-		//{
-		//	x_ *= value;
-		//	y_ *= value;
-		//	
-		//	return *this;
-		//}
-
-		friend Vector2D& operator*=(Vector2D& v, double value);
-		friend std::istream& operator>>(std::istream& in, Vectors::Vector2D& vec);
-	};
-
-	const Vector2D Vector2D::unit_x_(1.0, 0.0);
-	const Vector2D Vector2D::unit_y_(0.0, 1.0);
-
-	Vector2D operator+(const Vector2D& v1, const Vector2D& v2)
-	{
-		return Vector2D(v1.x() + v2.x(), v1.y() + v2.y());
-	}
-
-	Vector2D operator-(const Vector2D& v1, const Vector2D& v2)
-	{
-		return Vector2D(v1.x() - v2.x(), v1.y() - v2.y());
-	}
-
-	Vector2D operator-(const Vector2D& v1)
-	{
-		return Vector2D(-v1.x(), -v1.y());
-	}
-
-	bool operator==(const Vector2D& v1, const Vector2D& v2)
-	{
-		return ((v1.x() == v2.x()) && (v1.y() == v2.y()));
-	}
-	
-	bool operator!=(const Vector2D& v1, const Vector2D& v2)
-	{
-		return !(v1 == v2);
-	}
-
-	Vector2D operator*(double value, const Vector2D& v1)
-	{
-		return Vector2D(v1.x() * value, v1.y() * value);
-	}
-
-	double operator*(const Vector2D& v1, const Vector2D& v2)
-	{
-		return v1.x() * v2.x() + v1.y() * v2.y();
-	}
-
-	Vector2D& operator*=(Vector2D& v, double value)
-	{
-		v.x_ *= value;
-		v.y_ *= value;
-
-		return v;
-	}
-
-	std::ostream& operator<<(std::ostream& out, const Vector2D& vec)
-	{
-		out << std::fixed << std::setprecision(1) << "[" << vec.x() << ", " << vec.y() << "]";
-		return out;
-	}
-
-	std::istream& operator>>(std::istream& in, Vectors::Vector2D& vec)
-	{
-		// format: "[1.0, 2.0]"
-		const char left_bracket = '[';
-		const char right_bracket = ']';
-		const char comma = ',';
-
-		char start, separator, end;
-		double x, y;
-
-		if (in >> start && start != left_bracket)
-		{
-			in.unget();
-			in.clear(std::ios_base::failbit);
-			return in;
-		}
-
-		in >> x >> separator >> y >> end;
-
-
-		if (!in || (separator != comma) || (end != right_bracket))
-			throw std::runtime_error("Stream reading error");
-
-		vec.x_ = x;
-		vec.y_ = y;
-
-		return in;
-	}
-}
-
 using namespace Vectors;
 
 TEST_CASE("vector2D")
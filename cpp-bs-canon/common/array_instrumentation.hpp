@@ -0,0 +1,83 @@
+#ifndef ARRAY_INSTRUMENTATION_HPP
+#define ARRAY_INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <cstddef>
+
+// ARRAY_INSTRUMENTATION - 1: arrays count their constructions, copies, moves and allocated bytes
+//                         0: counting code compiles to nothing
+// by default on in debug builds and off in release builds (NDEBUG)
+#ifndef ARRAY_INSTRUMENTATION
+#ifdef NDEBUG
+#define ARRAY_INSTRUMENTATION 0
+#else
+#define ARRAY_INSTRUMENTATION 1
+#endif
+#endif
+
+namespace Instrumentation
+{
+	struct Counts
+	{
+		size_t constructions = 0;   // all constructors, including copy and move constructors
+		size_t copies = 0;          // copy constructors and copy assignments
+		size_t moves = 0;           // move constructors and move assignments
+		size_t bytes_allocated = 0;
+	};
+
+	// counters shared by all objects of type Tag
+	//  - relaxed atomic increments: lock-free and safe to use from many threads, values are exact once
+	//    the threads are joined
+#if ARRAY_INSTRUMENTATION
+	template <typename Tag>
+	class Counters
+	{
+		static_assert(std::atomic<size_t>::is_always_lock_free);
+
+		static inline std::atomic<size_t> constructions_{ 0 };
+		static inline std::atomic<size_t> copies_{ 0 };
+		static inline std::atomic<size_t> moves_{ 0 };
+		static inline std::atomic<size_t> bytes_allocated_{ 0 };
+
+	public:
+		static constexpr bool enabled = true;
+
+		static void construction() { constructions_.fetch_add(1, std::memory_order_relaxed); }
+		static void copy() { copies_.fetch_add(1, std::memory_order_relaxed); }
+		static void move() { moves_.fetch_add(1, std::memory_order_relaxed); }
+		static void allocation(size_t bytes) { bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed); }
+
+		static Counts get()
+		{
+			return Counts{ constructions_.load(std::memory_order_relaxed), copies_.load(std::memory_order_relaxed),
+				moves_.load(std::memory_order_relaxed), bytes_allocated_.load(std::memory_order_relaxed) };
+		}
+
+		static void reset()
+		{
+			constructions_ = 0;
+			copies_ = 0;
+			moves_ = 0;
+			bytes_allocated_ = 0;
+		}
+	};
+#else
+	template <typename Tag>
+	class Counters
+	{
+	public:
+		static constexpr bool enabled = false;
+
+		static void construction() {}
+		static void copy() {}
+		static void move() {}
+		static void allocation(size_t) {}
+
+		static Counts get() { return Counts{}; }
+
+		static void reset() {}
+	};
+#endif
+}
+
+#endif // ARRAY_INSTRUMENTATION_HPP
@@ -0,0 +1,49 @@
+#ifndef BINARY_INPUT_HPP
+#define BINARY_INPUT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <ios>
+#include <istream>
+
+// helpers for reading binary files whose sizes come from the file itself
+//  - a size read from a corrupted file can be anything, so it is checked against remaining_bytes()
+//    before anything is allocated, or - if the stream can't tell its size - the data is read with read_in_blocks()
+namespace BinaryInput
+{
+    // number of bytes left in the stream or -1 if the stream can't tell (it isn't seekable)
+    inline std::streamoff remaining_bytes(std::istream& in)
+    {
+        const std::streampos pos = in.tellg();
+        if (pos == std::streampos(-1))
+            return -1;
+
+        if (!in.seekg(0, std::ios::end))
+        {
+            in.clear();
+            in.seekg(pos);
+            return -1;
+        }
+
+        const std::streampos end = in.tellg();
+        in.seekg(pos);
+
+        return end != std::streampos(-1) ? static_cast<std::streamoff>(end - pos) : -1;
+    }
+
+    // reads count elements in blocks of block_size: resize(n) grows the storage to n elements,
+    // read(offset, n) fills n elements starting at offset and throws if the stream ends
+    //  - storage grows with the data actually read, so a corrupted count fails at the end of the stream
+    template <typename Resize, typename Read>
+    void read_in_blocks(size_t count, Resize resize, Read read, size_t block_size = 64 * 1024)
+    {
+        for (size_t offset = 0; offset < count; offset += block_size)
+        {
+            const size_t block = std::min(block_size, count - offset);
+            resize(offset + block);
+            read(offset, block);
+        }
+    }
+}
+
+#endif // BINARY_INPUT_HPP
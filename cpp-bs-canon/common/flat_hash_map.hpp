@@ -0,0 +1,428 @@
+#ifndef FLAT_HASH_MAP_HPP
+#define FLAT_HASH_MAP_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// append-only storage for strings - views returned by intern() stay valid until the arena is destroyed
+class StringArena
+{
+    static constexpr size_t block_size = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* current_ = nullptr;
+    size_t left_ = 0;
+
+public:
+    StringArena() = default;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    // the source is left empty - its next intern() starts a new block instead of writing into a moved block
+    StringArena(StringArena&& source) noexcept
+        : blocks_(std::move(source.blocks_)), current_(std::exchange(source.current_, nullptr)), left_(std::exchange(source.left_, 0))
+    {
+        source.blocks_.clear();
+    }
+
+    StringArena& operator=(StringArena&& source) noexcept
+    {
+        if (this != &source)
+        {
+            blocks_ = std::move(source.blocks_);
+            current_ = std::exchange(source.current_, nullptr);
+            left_ = std::exchange(source.left_, 0);
+            source.blocks_.clear();
+        }
+
+        return *this;
+    }
+
+    std::string_view intern(std::string_view str)
+    {
+        if (str.size() > left_)
+        {
+            const size_t size = std::max(block_size, str.size());
+            blocks_.push_back(std::make_unique<char[]>(size));
+            current_ = blocks_.back().get();
+            left_ = size;
+        }
+
+        char* dest = current_;
+        if (!str.empty())
+            std::memcpy(dest, str.data(), str.size());
+        current_ += str.size();
+        left_ -= str.size();
+
+        return std::string_view(dest, str.size());
+    }
+
+    void clear()
+    {
+        blocks_.clear();
+        current_ = nullptr;
+        left_ = 0;
+    }
+};
+
+// key storage for tables whose keys refer to the caller's buffers - nothing is copied,
+// the buffers must outlive the table (e.g. words of a memory-mapped file)
+struct ExternalKeys
+{
+    std::string_view intern(std::string_view str) const
+    {
+        return str;
+    }
+
+    void clear()
+    {
+    }
+};
+
+namespace Detail
+{
+    struct MapKey
+    {
+        template <typename Pair>
+        std::string_view operator()(const Pair& kv) const { return kv.first; }
+    };
+
+    struct SetKey
+    {
+        std::string_view operator()(std::string_view key) const { return key; }
+    };
+
+    // open addressing with linear probing over one contiguous array of slots
+    //  - every slot keeps the precomputed hash of its key (0 means an empty slot),
+    //    so a probe compares keys only when the hashes are equal
+    //  - keys are copied into KeyStorage - with the default StringArena the table never refers to the caller's buffers,
+    //    with ExternalKeys keys are stored as given
+    template <typename Value, typename KeyOf, typename KeyStorage = StringArena>
+    class FlatStringTable
+    {
+    protected:
+        struct Slot
+        {
+            size_t hash = 0;
+            Value value{};
+        };
+
+        std::vector<Slot> slots_;
+        size_t size_ = 0;
+        KeyStorage keys_;
+
+        template <bool IsConst>
+        class Iterator
+        {
+            using SlotPtr = std::conditional_t<IsConst, const Slot*, Slot*>;
+
+            SlotPtr slot_;
+            SlotPtr end_;
+
+            void skip_empty()
+            {
+                while (slot_ != end_ && slot_->hash == 0)
+                    ++slot_;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<IsConst, const Value*, Value*>;
+            using reference = std::conditional_t<IsConst, const Value&, Value&>;
+
+            Iterator(SlotPtr slot, SlotPtr end) : slot_(slot), end_(end)
+            {
+                skip_empty();
+            }
+
+            operator Iterator<true>() const
+            {
+                return Iterator<true>(slot_, end_);
+            }
+
+            reference operator*() const { return slot_->value; }
+            pointer operator->() const { return &slot_->value; }
+
+            Iterator& operator++()
+            {
+                ++slot_;
+                skip_empty();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator prev = *this;
+                ++(*this);
+                return prev;
+            }
+
+            bool operator==(const Iterator& other) const { return slot_ == other.slot_; }
+            bool operator!=(const Iterator& other) const { return slot_ != other.slot_; }
+        };
+
+        static size_t hash_of(std::string_view key)
+        {
+            const size_t hash = std::hash<std::string_view>{}(key);
+            return hash != 0 ? hash : 1;
+        }
+
+        size_t mask() const
+        {
+            return slots_.size() - 1;
+        }
+
+        // index of the slot holding key or of the empty slot where it should be inserted
+        size_t probe(std::string_view key, size_t hash) const
+        {
+            size_t index = hash & mask();
+
+            while (slots_[index].hash != 0)
+            {
+                if (slots_[index].hash == hash && KeyOf{}(slots_[index].value) == key)
+                    break;
+                index = (index + 1) & mask();
+            }
+
+            return index;
+        }
+
+        void rehash(size_t slot_count)
+        {
+            std::vector<Slot> old_slots(slot_count);
+            old_slots.swap(slots_);
+
+            for (auto& slot : old_slots)
+            {
+                if (slot.hash == 0)
+                    continue;
+
+                size_t index = slot.hash & mask();
+                while (slots_[index].hash != 0)
+                    index = (index + 1) & mask();
+
+                slots_[index] = std::move(slot);
+            }
+        }
+
+        // make_value(interned_key) builds the value stored for a new key
+        template <typename MakeValue>
+        std::pair<size_t, bool> insert_key(std::string_view key, MakeValue make_value)
+        {
+            // max load factor: 3/4
+            if ((size_ + 1) * 4 > slots_.size() * 3)
+                rehash(std::max<size_t>(16, slots_.size() * 2));
+
+            const size_t hash = hash_of(key);
+            const size_t index = probe(key, hash);
+
+            if (slots_[index].hash != 0)
+                return { index, false };
+
+            slots_[index].hash = hash;
+            slots_[index].value = make_value(keys_.intern(key));
+            ++size_;
+
+            return { index, true };
+        }
+
+        size_t find_index(std::string_view key) const
+        {
+            if (size_ == 0)
+                return slots_.size();
+
+            const size_t index = probe(key, hash_of(key));
+
+            return slots_[index].hash != 0 ? index : slots_.size();
+        }
+
+    public:
+        using key_type = std::string_view;
+        using value_type = Value;
+        using size_type = size_t;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        FlatStringTable() = default;
+
+        FlatStringTable(const FlatStringTable& source)
+        {
+            reserve(source.size());
+
+            for (const auto& slot : source.slots_)
+                if (slot.hash != 0)
+                    insert_key(KeyOf{}(slot.value), [&slot](std::string_view interned) { return rebind_key(slot.value, interned); });
+        }
+
+        FlatStringTable& operator=(const FlatStringTable& source)
+        {
+            FlatStringTable temp(source);
+            swap(temp);
+            return *this;
+        }
+
+        // the source is left as an empty table that can be used again
+        FlatStringTable(FlatStringTable&& source) noexcept
+            : slots_(std::move(source.slots_)), size_(std::exchange(source.size_, 0)), keys_(std::move(source.keys_))
+        {
+            source.slots_.clear();
+        }
+
+        FlatStringTable& operator=(FlatStringTable&& source) noexcept
+        {
+            if (this != &source)
+            {
+                slots_ = std::move(source.slots_);
+                size_ = std::exchange(source.size_, 0);
+                keys_ = std::move(source.keys_);
+                source.slots_.clear();
+            }
+
+            return *this;
+        }
+
+        void swap(FlatStringTable& other) noexcept
+        {
+            std::swap(slots_, other.slots_);
+            std::swap(size_, other.size_);
+            std::swap(keys_, other.keys_);
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        void reserve(size_t count)
+        {
+            size_t slot_count = 16;
+            while (slot_count * 3 < count * 4)
+                slot_count *= 2;
+
+            if (slot_count > slots_.size())
+                rehash(slot_count);
+        }
+
+        void clear()
+        {
+            slots_.clear();
+            size_ = 0;
+            keys_.clear();
+        }
+
+        iterator begin() { return iterator(slots_.data(), slots_.data() + slots_.size()); }
+        iterator end() { return iterator(slots_.data() + slots_.size(), slots_.data() + slots_.size()); }
+        const_iterator begin() const { return const_iterator(slots_.data(), slots_.data() + slots_.size()); }
+        const_iterator end() const { return const_iterator(slots_.data() + slots_.size(), slots_.data() + slots_.size()); }
+
+        iterator find(std::string_view key)
+        {
+            return iterator(slots_.data() + find_index(key), slots_.data() + slots_.size());
+        }
+
+        const_iterator find(std::string_view key) const
+        {
+            return const_iterator(slots_.data() + find_index(key), slots_.data() + slots_.size());
+        }
+
+        size_t count(std::string_view key) const
+        {
+            return find_index(key) != slots_.size() ? 1 : 0;
+        }
+
+        bool contains(std::string_view key) const
+        {
+            return count(key) != 0;
+        }
+
+    private:
+        template <typename T>
+        static std::pair<std::string_view, T> rebind_key(const std::pair<std::string_view, T>& kv, std::string_view key)
+        {
+            return { key, kv.second };
+        }
+
+        static std::string_view rebind_key(std::string_view, std::string_view key)
+        {
+            return key;
+        }
+    };
+}
+
+// drop-in replacement for std::unordered_map<std::string_view, T>
+//  - keys are copied into the map, so the source buffer may be released after insertion
+//    (FlatStringMap<T, ExternalKeys> stores the views as given instead)
+//  - elements are std::pair<std::string_view, T> - keys must not be modified through iterators
+template <typename T, typename KeyStorage = StringArena>
+class FlatStringMap : public Detail::FlatStringTable<std::pair<std::string_view, T>, Detail::MapKey, KeyStorage>
+{
+    using Base = Detail::FlatStringTable<std::pair<std::string_view, T>, Detail::MapKey, KeyStorage>;
+
+public:
+    using mapped_type = T;
+    using typename Base::iterator;
+
+    T& operator[](std::string_view key)
+    {
+        const auto [index, inserted] = this->insert_key(key, [](std::string_view interned) { return std::pair<std::string_view, T>(interned, T{}); });
+        return this->slots_[index].value.second;
+    }
+
+    std::pair<iterator, bool> insert(const std::pair<std::string_view, T>& kv)
+    {
+        const auto [index, inserted] = this->insert_key(kv.first, [&kv](std::string_view interned) { return std::pair<std::string_view, T>(interned, kv.second); });
+        return { iterator(this->slots_.data() + index, this->slots_.data() + this->slots_.size()), inserted };
+    }
+
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+};
+
+template <typename T, typename LhsKeys, typename RhsKeys>
+bool operator==(const FlatStringMap<T, LhsKeys>& lhs, const FlatStringMap<T, RhsKeys>& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    return std::all_of(lhs.begin(), lhs.end(), [&rhs](const auto& kv) {
+        auto it = rhs.find(kv.first);
+        return it != rhs.end() && it->second == kv.second;
+    });
+}
+
+template <typename T, typename LhsKeys, typename RhsKeys>
+bool operator!=(const FlatStringMap<T, LhsKeys>& lhs, const FlatStringMap<T, RhsKeys>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// drop-in replacement for std::unordered_set<std::string> with heterogeneous lookup by std::string_view
+class FlatStringSet : public Detail::FlatStringTable<std::string_view, Detail::SetKey>
+{
+public:
+    std::pair<iterator, bool> insert(std::string_view key)
+    {
+        const auto [index, inserted] = insert_key(key, [](std::string_view interned) { return interned; });
+        return { iterator(slots_.data() + index, slots_.data() + slots_.size()), inserted };
+    }
+};
+
+#endif // FLAT_HASH_MAP_HPP
@@ -0,0 +1,114 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// read-only memory mapping of a whole file - string_views into content() are valid as long as the object lives
+class MappedFile
+{
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& file_name)
+    {
+#ifdef _WIN32
+        file_ = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file_ == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("File " + file_name + " can't be opened");
+
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(file_, &file_size);
+        size_ = static_cast<size_t>(file_size.QuadPart);
+
+        if (size_ == 0)
+            return;
+
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_)
+            data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+
+        if (!data_)
+        {
+            close();
+            throw std::runtime_error("File " + file_name + " can't be mapped");
+        }
+#else
+        int fd = ::open(file_name.c_str(), O_RDONLY);
+
+        if (fd == -1)
+            throw std::runtime_error("File " + file_name + " can't be opened");
+
+        struct stat st;
+        if (::fstat(fd, &st) == 0)
+            size_ = static_cast<size_t>(st.st_size);
+
+        if (size_ > 0)
+        {
+            void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (addr == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("File " + file_name + " can't be mapped");
+            }
+
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(addr);
+        }
+
+        ::close(fd); // mapping stays valid after closing the descriptor
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    std::string_view content() const
+    {
+        return std::string_view(data_, size_);
+    }
+
+private:
+    void close()
+    {
+#ifdef _WIN32
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mapping_)
+            CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+#else
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+        data_ = nullptr;
+    }
+};
+
+#endif // MAPPED_FILE_HPP
@@ -8,76 +8,135 @@
 #include <deque>
 #include <set>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
 #include <unordered_map>
 
+#include "array_instrumentation.hpp"
 #include "catch.hpp"
 
 using namespace std;
 
+// tag for Array(size, uninitialized) - elements have indeterminate values until written
+struct uninitialized_t
+{
+	explicit uninitialized_t() = default;
+};
+
+inline constexpr uninitialized_t uninitialized{};
+
+// storage comes from a std::pmr::memory_resource - the default one (new/delete) unless an arena or a pool is passed
 class Array
 {
+public:
+	using allocator_type = std::pmr::polymorphic_allocator<int>;
+
 private:
+	using Counters = Instrumentation::Counters<Array>;
+
+	allocator_type alloc_;
 	size_t size_;
 	int* data_;
+
+	int* allocate(size_t size)
+	{
+		if (size == 0)
+			return nullptr;
+
+		Counters::allocation(size * sizeof(int));
+		return alloc_.allocate(size);
+	}
+
+	void deallocate()
+	{
+		if (data_ != nullptr)
+			alloc_.deallocate(data_, size_);
+	}
 public:
 	typedef int* iterator; // legacy style
 	using const_iterator = const int*; // since C++11
 
-	Array(size_t size, int value = 0)
-		: size_(size), data_(new int[size])
+	Array(size_t size, int value = 0, allocator_type alloc = {})
+		: alloc_(alloc), size_(size), data_(allocate(size))
 	{	
 		std::fill_n(data_, size_, value);
+		Counters::construction();
+	}
+
+	// for arrays that are overwritten right away - memory isn't touched twice
+	Array(size_t size, uninitialized_t, allocator_type alloc = {})
+		: alloc_(alloc), size_(size), data_(allocate(size))
+	{
+		Counters::construction();
 	}
 
 	// allows list initialization: Array a = {1, 2, 3}
-	Array(std::initializer_list<int> il)
-		: size_(il.size()), data_(new int[il.size()])
+	Array(std::initializer_list<int> il, allocator_type alloc = {})
+		: alloc_(alloc), size_(il.size()), data_(allocate(il.size()))
 	{
 		std::copy(il.begin(), il.end(), data_);
+		Counters::construction();
 	}
 
 	// copy constructor
-	Array(const Array& source) : size_(source.size_), data_(new int[source.size_])
+	Array(const Array& source) : size_(source.size_), data_(allocate(source.size_))
 	{
 		std::copy(source.begin(), source.end(), this->data_);
-		std::cout << "Array(const Array& - copy constructor)\n";
+		Counters::construction();
+		Counters::copy();
 	}
 
 	// copy assignment operator
+	//  - the copy is made before the old memory is freed, so the array is unchanged if the allocation throws
 	Array& operator=(const Array& source)
 	{
 		if (this != &source) // protection from self-assignment
 		{
-			delete[] data_; // free memory
+			int* data = allocate(source.size_);
+			std::copy(source.begin(), source.end(), data);
+
+			Counters::copy();
 
-			// copy of state from source object
+			deallocate(); // free memory
+
+			// take over the copy
 			size_ = source.size_;
-			data_ = new int[size_];
-			std::copy(source.begin(), source.end(), data_);
+			data_ = data;
 		}
 
 		return *this;
 	}
 
-	// move constructor
-	Array(Array&& source) : size_(source.size_), data_(source.data_)
+	// move constructor - noexcept, so std::vector<Array> moves arrays when it reallocates
+	Array(Array&& source) noexcept : alloc_(source.alloc_), size_(source.size_), data_(source.data_)
 	{
 		source.data_ = nullptr;
 		source.size_ = 0;
-		std::cout << "Array(Array&& - move constructor)\n";
+		Counters::construction();
+		Counters::move();
 	}
 
 	// move assignment operator
-	Array& operator=(Array&& source)
+	//  - noexcept only if the memory can always be taken - polymorphic_allocator doesn't propagate,
+	//    so arrays of different resources are copied
+	Array& operator=(Array&& source) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
+		|| std::allocator_traits<allocator_type>::is_always_equal::value)
 	{
 		if (this != &source) // protection from self-assignment
 		{
-			delete[] data_; // free memory
+			if (alloc_ != source.alloc_) // memory from another resource can't be taken over
+				return *this = static_cast<const Array&>(source);
+
+			Counters::move();
+
+			deallocate(); // free memory
 
 			// move state from the source object
 			size_ = source.size_;
 			data_ = source.data_;
 			source.data_ = nullptr;
+			source.size_ = 0;
 		}
 
 		return *this;
@@ -86,7 +145,12 @@ public:
 	// destructor
 	~Array()
 	{
-		delete[] data_;
+		deallocate();
+	}
+
+	allocator_type get_allocator() const
+	{
+		return alloc_;
 	}
 
 	iterator begin()
@@ -130,6 +194,9 @@ public:
 	}
 };
 
+static_assert(std::is_nothrow_move_constructible_v<Array>);
+static_assert(!std::is_nothrow_move_assignable_v<Array>);
+
 bool operator==(const Array& lhs, const Array& rhs)
 {
 	/*if (lhs.size() != rhs.size())
@@ -152,7 +219,7 @@ bool operator==(const Array& lhs, const Array& rhs)
 
 Array load_data()
 {
-	Array arr(1'000);
+	Array arr(1'000, uninitialized);
 
 	std::iota(arr.begin(), arr.end(), 0);
 
@@ -173,6 +240,56 @@ TEST_CASE("load data")
 	CHECK(target.size() == 1'000);
 }
 
+TEST_CASE("Array instrumentation counts copies and moves")
+{
+	using Counters = Instrumentation::Counters<Array>;
+	Counters::reset();
+
+	Array data = load_data();
+	Array backup = data;
+	Array target = std::move(data);
+	backup = target;
+
+	Array& same_backup = backup;
+	backup = same_backup; // self-assignment copies nothing, so it isn't counted
+
+	const auto counts = Counters::get();
+
+	if constexpr (Counters::enabled)
+	{
+		CHECK(counts.copies == 2);
+		CHECK(counts.moves >= 1); // load_data() may elide its move
+		CHECK(counts.bytes_allocated == 3 * 1'000 * sizeof(int));
+	}
+}
+
+TEST_CASE("Array with a memory resource")
+{
+	int buffer[64];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	Array arr1(10, 1, &arena);
+	Array arr2 = { { 1, 2, 3 }, &arena };
+
+	REQUIRE(arr1.begin() >= buffer);
+	REQUIRE(arr2.end() <= std::end(buffer));
+
+	// the arena has no upstream - allocation beyond the buffer fails instead of using the heap
+	REQUIRE_THROWS_AS(Array(100, 0, &arena), std::bad_alloc);
+
+	SECTION("failed assignment leaves the array unchanged")
+	{
+		const Array big(1'000, 2);
+
+		REQUIRE_THROWS_AS(arr1 = big, std::bad_alloc);
+		REQUIRE_THROWS_AS(arr1 = Array(1'000, 2), std::bad_alloc); // other resource - elements are copied
+
+		REQUIRE(arr1.size() == 10);
+		REQUIRE(arr1.begin() >= buffer);
+		REQUIRE(std::all_of(arr1.begin(), arr1.end(), [](int item) { return item == 1; }));
+	}
+}
+
 //TEST_CASE("Array - copy & assign")
 //{
 //	Array arr1 = { 1, 2, 3, 4 };
@@ -0,0 +1,531 @@
+#ifndef ARRAY_HPP
+#define ARRAY_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "array_instrumentation.hpp"
+
+// tags selecting how elements of a new Array are initialized
+//  - Array(size, value) - fill: every element is a copy of value
+//  - Array(size, default_init) - default-initialization: no writes for trivial types, default constructor otherwise
+//  - Array(size, uninitialized) - raw storage for trivial types only, elements must be written before they are read
+struct default_init_t
+{
+	explicit default_init_t() = default;
+};
+
+inline constexpr default_init_t default_init{};
+
+struct uninitialized_t
+{
+	explicit uninitialized_t() = default;
+};
+
+inline constexpr uninitialized_t uninitialized{};
+
+// T can be moved to another address with memcpy instead of its move constructor and destructor
+//  - true for trivially copyable types, specialized below for allocators and for Array itself
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::pmr::polymorphic_allocator<T>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// array with storage obtained from Allocator
+//  - Allocator follows the standard allocator requirements (std::allocator, std::pmr::polymorphic_allocator, ...)
+//  - elements are constructed with std::allocator_traits<Allocator>::construct, so allocator-aware elements
+//    (e.g. std::pmr::string) get the same memory resource as the array
+//  - every element is written exactly once during construction
+//  - resize/reserve/push_back grow the storage geometrically (capacity doubles), elements are relocated with memcpy
+//    if T is trivially relocatable, otherwise moved (copied if their move constructor may throw)
+//  - move constructor is noexcept, so std::vector<Array<T>> moves arrays when it reallocates
+//  - allocator-extended copy and move constructors make Array usable as an element of allocator-aware containers
+//    (PmrArray<PmrArray<T>>, std::pmr::vector<PmrArray<T>>) - nested arrays get the resource of the outer container
+//  - constructions, copies, moves and allocated bytes are counted in Instrumentation::Counters<Array>
+//    when ARRAY_INSTRUMENTATION is on (see array_instrumentation.hpp)
+template <typename T, typename Allocator = std::allocator<T>>
+class Array
+{
+private:
+	using AllocTraits = std::allocator_traits<Allocator>;
+	using Counters = Instrumentation::Counters<Array>;
+
+	// construct() of these allocators is a plain placement new - std::uninitialized_* algorithms do the same job
+	// and use memset/memcpy for trivial types
+	static constexpr bool placement_construct = std::is_same_v<Allocator, std::allocator<T>>
+		|| (std::is_same_v<Allocator, std::pmr::polymorphic_allocator<T>> && !std::uses_allocator_v<T, Allocator>);
+
+	Allocator alloc_;
+	size_t size_;
+	size_t capacity_;
+	T* data_;
+
+	// allocates raw storage for size elements and initializes them with init(data)
+	//  - init constructs all elements or destroys the constructed ones and throws
+	template <typename Init>
+	T* create(size_t size, Init init)
+	{
+		if (size == 0)
+			return nullptr;
+
+		T* data = allocate(size);
+		try
+		{
+			init(data);
+		}
+		catch (...)
+		{
+			AllocTraits::deallocate(alloc_, data, size);
+			throw;
+		}
+
+		return data;
+	}
+
+	// constructs element i with allocator_traits::construct(alloc_, data + i, args(i)...)
+	template <typename... Args>
+	void construct_each(T* data, size_t size, Args... args)
+	{
+		size_t constructed = 0;
+		try
+		{
+			for (; constructed < size; ++constructed)
+				AllocTraits::construct(alloc_, data + constructed, args(constructed)...);
+		}
+		catch (...)
+		{
+			for (size_t i = 0; i < constructed; ++i)
+				AllocTraits::destroy(alloc_, data + i);
+			throw;
+		}
+	}
+
+	T* create_filled(size_t size, const T& value)
+	{
+		return create(size, [&](T* data) {
+			if constexpr (placement_construct)
+				std::uninitialized_fill_n(data, size, value);
+			else
+				construct_each(data, size, [&value](size_t) -> const T& { return value; });
+		});
+	}
+
+	T* create_copy(size_t size, const T* source)
+	{
+		return create(size, [&](T* data) {
+			if constexpr (placement_construct)
+				std::uninitialized_copy_n(source, size, data);
+			else
+				construct_each(data, size, [source](size_t i) -> const T& { return source[i]; });
+		});
+	}
+
+	void destroy_elements(T* data, size_t size)
+	{
+		if constexpr (placement_construct)
+			std::destroy_n(data, size);
+		else
+		{
+			for (size_t i = 0; i < size; ++i)
+				AllocTraits::destroy(alloc_, data + i);
+		}
+	}
+
+	void destroy(T* data, size_t size, size_t capacity)
+	{
+		if (data == nullptr)
+			return;
+
+		destroy_elements(data, size);
+		AllocTraits::deallocate(alloc_, data, capacity);
+	}
+
+	T* allocate(size_t capacity)
+	{
+		T* data = AllocTraits::allocate(alloc_, capacity);
+		Counters::allocation(capacity * sizeof(T));
+		return data;
+	}
+
+	size_t next_capacity(size_t required) const
+	{
+		return std::max(required, 2 * capacity_);
+	}
+
+	// moves elements to new_data and destroys them in the old storage - if it throws, the old storage is intact
+	void relocate(T* new_data)
+	{
+		if (size_ == 0)
+			return;
+
+		if constexpr (placement_construct && is_trivially_relocatable_v<T>)
+			std::memcpy(static_cast<void*>(new_data), static_cast<const void*>(data_), size_ * sizeof(T));
+		else
+		{
+			construct_each(new_data, size_, [this](size_t i) -> decltype(auto) { return std::move_if_noexcept(data_[i]); });
+			destroy_elements(data_, size_);
+		}
+	}
+
+	// replaces the storage with a new one for new_capacity elements
+	void reallocate(size_t new_capacity)
+	{
+		T* new_data = allocate(new_capacity);
+		try
+		{
+			relocate(new_data);
+		}
+		catch (...)
+		{
+			AllocTraits::deallocate(alloc_, new_data, new_capacity);
+			throw;
+		}
+
+		if (data_ != nullptr)
+			AllocTraits::deallocate(alloc_, data_, capacity_);
+		data_ = new_data;
+		capacity_ = new_capacity;
+	}
+
+public:
+	typedef T* iterator; // legacy style
+	using const_iterator = const T*; // since C++11
+	using allocator_type = Allocator;
+
+	explicit Array(const Allocator& alloc)
+		: alloc_(alloc), size_(0), capacity_(0), data_(nullptr)
+	{
+		Counters::construction();
+	}
+
+	Array(size_t size = 0, T value = T{}, const Allocator& alloc = Allocator{})
+		: alloc_(alloc), size_(size), capacity_(size), data_(create_filled(size, value))
+	{
+		Counters::construction();
+	}
+
+	Array(size_t size, default_init_t, const Allocator& alloc = Allocator{})
+		: alloc_(alloc), size_(size), capacity_(size), data_(create(size, [&](T* data) {
+			if constexpr (std::is_trivially_default_constructible_v<T>)
+				return; // default-initialization of a trivial type doesn't write anything
+			else if constexpr (placement_construct)
+				std::uninitialized_default_construct_n(data, size);
+			else
+				construct_each(data, size);
+		}))
+	{
+		Counters::construction();
+	}
+
+	Array(size_t size, uninitialized_t, const Allocator& alloc = Allocator{})
+		: alloc_(alloc), size_(size), capacity_(size), data_(create(size, [](T*) {}))
+	{
+		static_assert(std::is_trivial_v<T>, "uninitialized storage is allowed only for trivial types - use default_init");
+		Counters::construction();
+	}
+
+	// allows list initialization: Array a = {1, 2, 3}
+	Array(std::initializer_list<T> il, const Allocator& alloc = Allocator{})
+		: alloc_(alloc), size_(il.size()), capacity_(il.size()), data_(create_copy(il.size(), il.begin()))
+	{
+		Counters::construction();
+	}
+
+	// copy constructor
+	Array(const Array& source)
+		: alloc_(AllocTraits::select_on_container_copy_construction(source.alloc_)), size_(source.size_),
+		  capacity_(source.size_), data_(create_copy(source.size_, source.data_))
+	{
+		Counters::construction();
+		Counters::copy();
+	}
+
+	// allocator-extended copy constructor - used by uses-allocator construction, e.g. for arrays nested in PmrArray
+	Array(const Array& source, const Allocator& alloc)
+		: alloc_(alloc), size_(source.size_), capacity_(source.size_), data_(create_copy(source.size_, source.data_))
+	{
+		Counters::construction();
+		Counters::copy();
+	}
+
+	// copy assignment operator
+	Array& operator=(const Array& source)
+	{
+		if (this != &source) // protection from self-assignment
+		{
+			Counters::copy();
+
+			destroy(data_, size_, capacity_); // free memory
+			data_ = nullptr;
+			size_ = capacity_ = 0;
+
+			if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+				alloc_ = source.alloc_;
+
+			// copy of state from source object
+			data_ = create_copy(source.size_, source.data_);
+			size_ = capacity_ = source.size_;
+		}
+
+		return *this;
+	}
+
+	// move constructor
+	Array(Array&& source) noexcept
+		: alloc_(std::move(source.alloc_)), size_(source.size_), capacity_(source.capacity_), data_(source.data_)
+	{
+		source.data_ = nullptr;
+		source.size_ = source.capacity_ = 0;
+		Counters::construction();
+		Counters::move();
+	}
+
+	// allocator-extended move constructor
+	//  - memory of the source is taken only if alloc can free it, otherwise elements are moved one by one
+	Array(Array&& source, const Allocator& alloc) noexcept(AllocTraits::is_always_equal::value)
+		: alloc_(alloc), size_(0), capacity_(0), data_(nullptr)
+	{
+		if (AllocTraits::is_always_equal::value || alloc_ == source.alloc_)
+		{
+			data_ = source.data_;
+			size_ = source.size_;
+			capacity_ = source.capacity_;
+			source.data_ = nullptr;
+			source.size_ = source.capacity_ = 0;
+		}
+		else
+		{
+			data_ = create(source.size_, [&](T* data) {
+				construct_each(data, source.size_, [&source](size_t i) -> T&& { return std::move(source.data_[i]); });
+			});
+			size_ = capacity_ = source.size_;
+		}
+
+		Counters::construction();
+		Counters::move();
+	}
+
+	// move assignment operator
+	//  - memory of the source can be taken only if it can be freed with the allocator of this array,
+	//    otherwise elements are moved one by one (e.g. between arrays of different arenas)
+	//  - noexcept if the memory can always be taken
+	Array& operator=(Array&& source) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+	{
+		if (this != &source) // protection from self-assignment
+		{
+			Counters::move();
+
+			destroy(data_, size_, capacity_); // free memory
+			data_ = nullptr;
+			size_ = capacity_ = 0;
+
+			if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+				alloc_ = std::move(source.alloc_);
+
+			if (AllocTraits::propagate_on_container_move_assignment::value || alloc_ == source.alloc_)
+			{
+				// move state from the source object
+				data_ = source.data_;
+				size_ = source.size_;
+				capacity_ = source.capacity_;
+				source.data_ = nullptr;
+				source.size_ = source.capacity_ = 0;
+			}
+			else
+			{
+				data_ = create(source.size_, [&](T* data) {
+					construct_each(data, source.size_, [&source](size_t i) -> T&& { return std::move(source.data_[i]); });
+				});
+				size_ = capacity_ = source.size_;
+			}
+		}
+
+		return *this;
+	}
+
+	// destructor
+	~Array()
+	{
+		destroy(data_, size_, capacity_);
+	}
+
+	allocator_type get_allocator() const
+	{
+		return alloc_;
+	}
+
+private:
+	// shrinks to new_size or constructs elements up to new_size with construct(data, count) - capacity must suffice
+	template <typename Construct>
+	void resize_with(size_t new_size, Construct construct)
+	{
+		if (new_size < size_)
+			destroy_elements(data_ + new_size, size_ - new_size);
+		else
+			construct(data_ + size_, new_size - size_);
+
+		size_ = new_size;
+	}
+
+public:
+
+	iterator begin()
+	{
+		return data_;
+	}
+
+	const_iterator begin() const
+	{
+		return data_;
+	}
+
+	iterator end()
+	{
+		return data_ + size_;
+	}
+
+	const_iterator end() const
+	{
+		return data_ + size_;
+	}
+
+	void reset(int value)
+	{
+		std::fill_n(data_, size_, value);
+	}
+
+	size_t size() const
+	{
+		return this->size_;
+	}
+
+	size_t capacity() const
+	{
+		return capacity_;
+	}
+
+	void reserve(size_t new_capacity)
+	{
+		if (new_capacity > capacity_)
+			reallocate(new_capacity);
+	}
+
+	// new elements are value-initialized
+	void resize(size_t new_size)
+	{
+		if (new_size > capacity_)
+			reallocate(next_capacity(new_size));
+
+		resize_with(new_size, [this](T* data, size_t count) { construct_each(data, count); });
+	}
+
+	void resize(size_t new_size, const T& value)
+	{
+		if (new_size > capacity_)
+		{
+			const T copy = value; // value may be an element of this array
+			reallocate(next_capacity(new_size));
+			resize_with(new_size, [this, &copy](T* data, size_t count) { construct_each(data, count, [&copy](size_t) -> const T& { return copy; }); });
+		}
+		else
+			resize_with(new_size, [this, &value](T* data, size_t count) { construct_each(data, count, [&value](size_t) -> const T& { return value; }); });
+	}
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (size_ == capacity_)
+		{
+			// the new element is constructed before relocation - args may refer to elements of this array
+			const size_t new_capacity = next_capacity(size_ + 1);
+			T* new_data = allocate(new_capacity);
+			try
+			{
+				AllocTraits::construct(alloc_, new_data + size_, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				AllocTraits::deallocate(alloc_, new_data, new_capacity);
+				throw;
+			}
+
+			try
+			{
+				relocate(new_data);
+			}
+			catch (...)
+			{
+				AllocTraits::destroy(alloc_, new_data + size_);
+				AllocTraits::deallocate(alloc_, new_data, new_capacity);
+				throw;
+			}
+
+			if (data_ != nullptr)
+				AllocTraits::deallocate(alloc_, data_, capacity_);
+			data_ = new_data;
+			capacity_ = new_capacity;
+		}
+		else
+			AllocTraits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+
+		return data_[size_++];
+	}
+
+	void push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	void push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	T& operator[](size_t index)
+	{
+		return data_[index];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		return data_[index];
+	}
+};
+
+template <typename T, typename Allocator>
+bool operator==(const Array<T, Allocator>& lhs, const Array<T, Allocator>& rhs)
+{
+	return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+// Array with storage from a std::pmr::memory_resource, for example:
+//  - std::pmr::monotonic_buffer_resource - arena: bump-pointer allocation, everything freed at once
+//  - std::pmr::unsynchronized_pool_resource - pools of blocks in size classes, reused after deallocation
+// Array is a pointer, two sizes and an allocator - it can be relocated with memcpy if its allocator can
+template <typename T, typename Allocator>
+struct is_trivially_relocatable<Array<T, Allocator>> : is_trivially_relocatable<Allocator>
+{
+};
+
+template <typename T>
+using PmrArray = Array<T, std::pmr::polymorphic_allocator<T>>;
+
+#endif // ARRAY_HPP
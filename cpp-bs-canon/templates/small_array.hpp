@@ -0,0 +1,216 @@
+#ifndef SMALL_ARRAY_HPP
+#define SMALL_ARRAY_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// fixed-size array with storage for up to N elements inside the object (small buffer optimization)
+//  - arrays with size() <= N don't allocate, bigger ones get storage from Allocator like Array<T, Allocator>
+//  - moving a heap-backed array takes its memory (O(1)), moving an inline array moves its elements (at most N)
+template <typename T, size_t N = 16, typename Allocator = std::allocator<T>>
+class SmallArray
+{
+	static_assert(N > 0, "SmallArray needs room for at least one inline element");
+
+private:
+	using AllocTraits = std::allocator_traits<Allocator>;
+
+	Allocator alloc_;
+	size_t size_;
+	T* data_;
+	alignas(T) unsigned char buffer_[N * sizeof(T)];
+
+	T* inline_data()
+	{
+		return reinterpret_cast<T*>(buffer_);
+	}
+
+	// constructs size elements with make(i) in inline or allocated storage - nothing leaks if construction throws
+	template <typename Make>
+	void create(size_t size, Make make)
+	{
+		T* data = size <= N ? inline_data() : AllocTraits::allocate(alloc_, size);
+
+		size_t constructed = 0;
+		try
+		{
+			for (; constructed < size; ++constructed)
+				AllocTraits::construct(alloc_, data + constructed, make(constructed));
+		}
+		catch (...)
+		{
+			for (size_t i = 0; i < constructed; ++i)
+				AllocTraits::destroy(alloc_, data + i);
+			if (data != inline_data())
+				AllocTraits::deallocate(alloc_, data, size);
+			throw;
+		}
+
+		data_ = data;
+		size_ = size;
+	}
+
+	// leaves an empty array using the inline buffer
+	void destroy()
+	{
+		for (size_t i = 0; i < size_; ++i)
+			AllocTraits::destroy(alloc_, data_ + i);
+		if (!is_inline())
+			AllocTraits::deallocate(alloc_, data_, size_);
+
+		data_ = inline_data();
+		size_ = 0;
+	}
+
+	void take(SmallArray& source)
+	{
+		if (source.is_inline())
+			create(source.size_, [&source](size_t i) -> T&& { return std::move(source.data_[i]); });
+		else
+		{
+			data_ = source.data_;
+			size_ = source.size_;
+			source.data_ = source.inline_data();
+			source.size_ = 0;
+		}
+
+		source.destroy();
+	}
+
+public:
+	using iterator = T*;
+	using const_iterator = const T*;
+	using allocator_type = Allocator;
+
+	static constexpr size_t inline_capacity = N;
+
+	explicit SmallArray(const Allocator& alloc)
+		: alloc_(alloc), size_(0), data_(inline_data())
+	{
+	}
+
+	SmallArray(size_t size = 0, T value = T{}, const Allocator& alloc = Allocator{})
+		: alloc_(alloc), size_(0), data_(inline_data())
+	{
+		create(size, [&value](size_t) -> const T& { return value; });
+	}
+
+	SmallArray(std::initializer_list<T> il, const Allocator& alloc = Allocator{})
+		: alloc_(alloc), size_(0), data_(inline_data())
+	{
+		create(il.size(), [&il](size_t i) -> const T& { return il.begin()[i]; });
+	}
+
+	SmallArray(const SmallArray& source)
+		: alloc_(AllocTraits::select_on_container_copy_construction(source.alloc_)), size_(0), data_(inline_data())
+	{
+		create(source.size_, [&source](size_t i) -> const T& { return source.data_[i]; });
+	}
+
+	SmallArray& operator=(const SmallArray& source)
+	{
+		if (this != &source)
+		{
+			destroy();
+
+			if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+				alloc_ = source.alloc_;
+
+			create(source.size_, [&source](size_t i) -> const T& { return source.data_[i]; });
+		}
+
+		return *this;
+	}
+
+	SmallArray(SmallArray&& source) noexcept(std::is_nothrow_move_constructible_v<T>)
+		: alloc_(std::move(source.alloc_)), size_(0), data_(inline_data())
+	{
+		take(source);
+	}
+
+	// heap memory of the source is taken only if it can be freed with the allocator of this array
+	//  - noexcept if elements can't throw when an inline source is moved and the heap memory can always be taken
+	SmallArray& operator=(SmallArray&& source) noexcept(std::is_nothrow_move_constructible_v<T>
+		&& (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value))
+	{
+		if (this != &source)
+		{
+			destroy();
+
+			if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+				alloc_ = std::move(source.alloc_);
+
+			if (AllocTraits::propagate_on_container_move_assignment::value || alloc_ == source.alloc_)
+				take(source);
+			else
+			{
+				create(source.size_, [&source](size_t i) -> T&& { return std::move(source.data_[i]); });
+				source.destroy();
+			}
+		}
+
+		return *this;
+	}
+
+	~SmallArray()
+	{
+		destroy();
+	}
+
+	allocator_type get_allocator() const
+	{
+		return alloc_;
+	}
+
+	// true if elements are stored inside the object
+	bool is_inline() const
+	{
+		return data_ == reinterpret_cast<const T*>(buffer_);
+	}
+
+	iterator begin()
+	{
+		return data_;
+	}
+
+	const_iterator begin() const
+	{
+		return data_;
+	}
+
+	iterator end()
+	{
+		return data_ + size_;
+	}
+
+	const_iterator end() const
+	{
+		return data_ + size_;
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+	T& operator[](size_t index)
+	{
+		return data_[index];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		return data_[index];
+	}
+};
+
+template <typename T, size_t N, typename Allocator>
+bool operator==(const SmallArray<T, N, Allocator>& lhs, const SmallArray<T, N, Allocator>& rhs)
+{
+	return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+#endif // SMALL_ARRAY_HPP
@@ -1,135 +1,176 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <memory_resource>
+#include <new>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 #include <tuple>
 
+#include "array.hpp"
 #include "catch.hpp"
+#include "small_array.hpp"
 
 using namespace std;
 
-template <typename T>
-class Array
+// counts calls of the global operator new - allows tests to check that a piece of code doesn't use the heap
+//  - the whole family is replaced (plain, array, nothrow and aligned forms with matching deletes),
+//    so every allocation is counted and every pointer is freed by the function that matches its allocation
+namespace
 {
-private:
-	size_t size_;
-	T* data_;
-public:
-	typedef T* iterator; // legacy style
-	using const_iterator = const T*; // since C++11
+	std::atomic<size_t> global_heap_calls{ 0 };
 
-	Array(size_t size = 0, T value = T{})
-		: size_(size), data_(new T[size])
+	bool is_over_aligned(size_t alignment)
 	{
-		std::fill_n(data_, size_, value);
+		return alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
 	}
 
-	// allows list initialization: Array a = {1, 2, 3}
-	Array(std::initializer_list<T> il)
-		: size_(il.size()), data_(new T[il.size()])
+	void* heap_allocate(size_t size, size_t alignment) noexcept
 	{
-		std::copy(il.begin(), il.end(), data_);
+		++global_heap_calls;
+
+		if (size == 0)
+			size = 1;
+
+		if (!is_over_aligned(alignment))
+			return std::malloc(size);
+
+#ifdef _WIN32
+		return _aligned_malloc(size, alignment);
+#else
+		return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment); // size must be a multiple of alignment
+#endif
 	}
 
-	// copy constructor
-	Array(const Array& source) : size_(source.size_), data_(new T[source.size_])
+	void* heap_allocate_or_throw(size_t size, size_t alignment)
 	{
-		std::copy(source.begin(), source.end(), this->data_);
-		std::cout << "Array(const Array& - copy constructor)\n";
+		if (void* p = heap_allocate(size, alignment))
+			return p;
+
+		throw std::bad_alloc{};
 	}
 
-	// copy assignment operator
-	Array& operator=(const Array& source)
+	void heap_free(void* p, size_t alignment) noexcept
 	{
-		if (this != &source) // protection from self-assignment
+		if (!is_over_aligned(alignment))
+			std::free(p);
+		else
 		{
-			delete[] data_; // free memory
-
-			// copy of state from source object
-			size_ = source.size_;
-			data_ = new T[size_];
-			std::copy(source.begin(), source.end(), data_);
+#ifdef _WIN32
+			_aligned_free(p);
+#else
+			std::free(p);
+#endif
 		}
-
-		return *this;
 	}
 
-	// move constructor
-	Array(Array&& source) : size_(source.size_), data_(source.data_)
-	{
-		source.data_ = nullptr;
-		source.size_ = 0;
-		std::cout << "Array(Array&& - move constructor)\n";
-	}
+	constexpr size_t default_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
 
-	// move assignment operator
-	Array& operator=(Array&& source)
-	{
-		if (this != &source) // protection from self-assignment
-		{
-			delete[] data_; // free memory
+void* operator new(size_t size)
+{
+	return heap_allocate_or_throw(size, default_alignment);
+}
 
-			// move state from the source object
-			size_ = source.size_;
-			data_ = source.data_;
-			source.data_ = nullptr;
-		}
+void* operator new[](size_t size)
+{
+	return heap_allocate_or_throw(size, default_alignment);
+}
 
-		return *this;
-	}
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return heap_allocate_or_throw(size, static_cast<size_t>(alignment));
+}
 
-	// destructor
-	~Array()
-	{
-		delete[] data_;
-	}
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return heap_allocate_or_throw(size, static_cast<size_t>(alignment));
+}
 
-	iterator begin()
-	{
-		return data_;
-	}
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return heap_allocate(size, default_alignment);
+}
 
-	const_iterator begin() const
-	{
-		return data_;
-	}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return heap_allocate(size, default_alignment);
+}
 
-	iterator end()
-	{
-		return data_ + size_;
-	}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return heap_allocate(size, static_cast<size_t>(alignment));
+}
 
-	const_iterator end() const
-	{
-		return data_ + size_;
-	}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return heap_allocate(size, static_cast<size_t>(alignment));
+}
 
-	void reset(int value)
-	{
-		std::fill_n(data_, size_, value);
-	}
+void operator delete(void* p) noexcept
+{
+	heap_free(p, default_alignment);
+}
 
-	size_t size() const
-	{
-		return this->size_;
-	}
+void operator delete[](void* p) noexcept
+{
+	heap_free(p, default_alignment);
+}
 
-	T& operator[](size_t index)
-	{
-		return data_[index];
-	}
+void operator delete(void* p, size_t) noexcept
+{
+	heap_free(p, default_alignment);
+}
 
-	const T& operator[](size_t index) const
-	{
-		return data_[index];
-	}
-};
+void operator delete[](void* p, size_t) noexcept
+{
+	heap_free(p, default_alignment);
+}
 
-template <typename T>
-bool operator==(const Array<T>& lhs, const Array<T>& rhs)
+void operator delete(void* p, std::align_val_t alignment) noexcept
 {
-	return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	heap_free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept
+{
+	heap_free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p, size_t, std::align_val_t alignment) noexcept
+{
+	heap_free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* p, size_t, std::align_val_t alignment) noexcept
+{
+	heap_free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	heap_free(p, default_alignment);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	heap_free(p, default_alignment);
+}
+
+void operator delete(void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	heap_free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	heap_free(p, static_cast<size_t>(alignment));
 }
 
 template <typename T>
@@ -190,4 +231,628 @@ TEST_CASE("arrays & default constructor")
 
 	std::vector<Data> vec;
 	vec.push_back(Data{ 1 });
-}
\ No newline at end of file
+}
+
+TEST_CASE("global heap counter")
+{
+	struct alignas(64) OverAligned
+	{
+		char data[64];
+	};
+
+	const size_t heap_calls_before = global_heap_calls;
+
+	delete new int(1);
+	delete[] new int[10];
+	delete new (std::nothrow) int(2);
+	delete new OverAligned;
+	delete[] new OverAligned[2];
+
+	REQUIRE(global_heap_calls - heap_calls_before == 5);
+}
+
+TEST_CASE("Array with allocators")
+{
+	SECTION("std::allocator by default")
+	{
+		Array<int> arr(3, 7);
+
+		REQUIRE(arr == Array<int>{ 7, 7, 7 });
+		REQUIRE(std::is_same_v<Array<int>::allocator_type, std::allocator<int>>);
+	}
+
+	SECTION("no global heap calls within a request scope using an arena")
+	{
+		std::array<std::byte, 16 * 1024> buffer;
+		std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+
+		const size_t heap_calls_before = global_heap_calls;
+		size_t sum = 0;
+		bool names_in_arena = false;
+		{
+			// request scope
+			PmrArray<int> numbers(100, 1, &arena);
+			PmrArray<std::pmr::string> names(3, std::pmr::string("a string too long for the small string optimization", &arena), &arena);
+			PmrArray<int> other(10, 2, &arena);
+			other = numbers;
+
+			sum = std::accumulate(numbers.begin(), numbers.end(), 0) + std::accumulate(other.begin(), other.end(), 0);
+			names_in_arena = names[2].get_allocator().resource() == &arena;
+		}
+		const size_t heap_calls_after = global_heap_calls;
+
+		REQUIRE(sum == 200);
+		REQUIRE(names_in_arena);
+		REQUIRE(heap_calls_after == heap_calls_before);
+	}
+
+	SECTION("elements get the memory resource of the array")
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		PmrArray<std::pmr::string> names(2, std::pmr::string{}, &arena);
+		PmrArray<std::pmr::string> copy(names);
+
+		REQUIRE(names[0].get_allocator().resource() == &arena);
+		// polymorphic_allocator doesn't propagate on copy - copies use the default resource
+		REQUIRE(copy[0].get_allocator().resource() == std::pmr::get_default_resource());
+	}
+
+	SECTION("pool reuses blocks of freed arrays")
+	{
+		std::array<std::byte, 16 * 1024> buffer;
+		std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+		std::pmr::unsynchronized_pool_resource pool(&arena);
+
+		const int* first_data = nullptr;
+		{
+			PmrArray<int> arr(10, 0, &pool);
+			first_data = arr.begin();
+		}
+
+		const size_t heap_calls_before = global_heap_calls;
+		const int* second_data = nullptr;
+		for (int i = 0; i < 1000; ++i)
+		{
+			PmrArray<int> arr(10, i, &pool);
+			second_data = arr.begin();
+		}
+		const size_t heap_calls_after = global_heap_calls;
+
+		REQUIRE(second_data == first_data);
+		REQUIRE(heap_calls_after == heap_calls_before);
+	}
+
+	SECTION("move assignment")
+	{
+		std::pmr::monotonic_buffer_resource arena1;
+		std::pmr::monotonic_buffer_resource arena2;
+
+		PmrArray<int> source(5, 1, &arena1);
+		const int* source_data = source.begin();
+
+		SECTION("with the same resource takes the memory")
+		{
+			PmrArray<int> target(&arena1);
+			target = std::move(source);
+
+			REQUIRE(target.begin() == source_data);
+			REQUIRE(source.size() == 0);
+		}
+
+		SECTION("with a different resource moves elements into own memory")
+		{
+			PmrArray<int> target(&arena2);
+			target = std::move(source);
+
+			REQUIRE(target.begin() != source_data);
+			REQUIRE(target == PmrArray<int>(5, 1));
+			REQUIRE(target.get_allocator().resource() == &arena2);
+		}
+	}
+
+	SECTION("nested arrays get the resource of the outer container")
+	{
+		std::pmr::monotonic_buffer_resource arena;
+
+		PmrArray<PmrArray<int>> nested(3, PmrArray<int>(2, 1), &arena);
+
+		REQUIRE(nested.size() == 3);
+		REQUIRE(nested[2] == PmrArray<int>{ 1, 1 });
+		REQUIRE(nested[2].get_allocator().resource() == &arena);
+
+		std::pmr::vector<PmrArray<int>> vec(&arena);
+		const PmrArray<int> item(2, 5);
+		for (int i = 0; i < 10; ++i)
+			vec.push_back(item);
+		vec.push_back(PmrArray<int>(3, 7));
+
+		REQUIRE(vec.size() == 11);
+		REQUIRE(vec[0] == item);
+		REQUIRE(vec[10] == PmrArray<int>{ 7, 7, 7 });
+		REQUIRE(std::all_of(vec.begin(), vec.end(), [&arena](const auto& arr) { return arr.get_allocator().resource() == &arena; }));
+	}
+}
+
+namespace
+{
+	// simulates requests creating many short-lived arrays of different sizes
+	template <typename MakeArray>
+	size_t handle_request(MakeArray make_array)
+	{
+		size_t sum = 0;
+		for (size_t i = 0; i < 1'000; ++i)
+		{
+			auto arr = make_array(1 + i % 64);
+			sum += arr[arr.size() - 1];
+		}
+		return sum;
+	}
+
+	template <typename ThreadBody>
+	void run_threads(ThreadBody body)
+	{
+		const size_t thread_count = std::max(std::thread::hardware_concurrency(), 4u);
+
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < thread_count; ++i)
+			threads.emplace_back(body);
+
+		for (auto& thd : threads)
+			thd.join();
+	}
+
+	constexpr size_t requests_per_thread = 100;
+}
+
+TEST_CASE("Array allocators under multi-threaded churn", "[.benchmark]")
+{
+	BENCHMARK("std::allocator (new[])")
+	{
+		run_threads([] {
+			for (size_t r = 0; r < requests_per_thread; ++r)
+				handle_request([](size_t size) { return Array<int>(size, 1); });
+		});
+	};
+
+	BENCHMARK("arena per request")
+	{
+		run_threads([] {
+			std::array<std::byte, 256 * 1024> buffer;
+			for (size_t r = 0; r < requests_per_thread; ++r)
+			{
+				std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+				handle_request([&arena](size_t size) { return PmrArray<int>(size, 1, &arena); });
+			}
+		});
+	};
+
+	BENCHMARK("pool per thread")
+	{
+		run_threads([] {
+			std::pmr::unsynchronized_pool_resource pool;
+			for (size_t r = 0; r < requests_per_thread; ++r)
+				handle_request([&pool](size_t size) { return PmrArray<int>(size, 1, &pool); });
+		});
+	};
+}
+
+TEST_CASE("SmallArray")
+{
+	SECTION("small arrays are stored inline without heap allocation")
+	{
+		const size_t heap_calls_before = global_heap_calls;
+		SmallArray<int, 8> arr(8, 1);
+		SmallArray<int, 8> il = { 1, 2, 3 };
+		const size_t heap_calls_after = global_heap_calls;
+
+		REQUIRE(heap_calls_after == heap_calls_before);
+		REQUIRE(arr.is_inline());
+		REQUIRE(il.is_inline());
+		REQUIRE(il == SmallArray<int, 8>{ 1, 2, 3 });
+	}
+
+	SECTION("big arrays are stored on the heap")
+	{
+		SmallArray<int, 8> arr(9, 1);
+
+		REQUIRE_FALSE(arr.is_inline());
+		REQUIRE(std::count(arr.begin(), arr.end(), 1) == 9);
+	}
+
+	SECTION("copy")
+	{
+		SmallArray<std::string, 2> small = { "one", "two" };
+		SmallArray<std::string, 2> big = { "one", "two", "three" };
+
+		SmallArray<std::string, 2> small_copy = small;
+		SmallArray<std::string, 2> big_copy = big;
+
+		REQUIRE(small_copy == small);
+		REQUIRE(small_copy.is_inline());
+		REQUIRE(small_copy.begin() != small.begin());
+		REQUIRE(big_copy == big);
+		REQUIRE(big_copy.begin() != big.begin());
+
+		small_copy = big;
+		REQUIRE(small_copy == big);
+		big_copy = small;
+		REQUIRE(big_copy == small);
+		REQUIRE(big_copy.is_inline());
+	}
+
+	SECTION("move of an inline array moves elements")
+	{
+		SmallArray<std::string, 2> source = { "one", "two" };
+
+		SmallArray<std::string, 2> target = std::move(source);
+
+		REQUIRE(target == SmallArray<std::string, 2>{ "one", "two" });
+		REQUIRE(target.is_inline());
+		REQUIRE(source.size() == 0);
+	}
+
+	SECTION("move of a heap array takes memory")
+	{
+		SmallArray<std::string, 2> source = { "one", "two", "three" };
+		const std::string* data = source.begin();
+
+		SmallArray<std::string, 2> target = std::move(source);
+		REQUIRE(target.begin() == data);
+		REQUIRE(source.size() == 0);
+		REQUIRE(source.is_inline());
+
+		SmallArray<std::string, 2> other = { "four" };
+		other = std::move(target);
+		REQUIRE(other.begin() == data);
+
+		other = SmallArray<std::string, 2>{ "five" };
+		REQUIRE(other == SmallArray<std::string, 2>{ "five" });
+		REQUIRE(other.is_inline());
+	}
+
+	SECTION("move is noexcept for nothrow movable elements")
+	{
+		static_assert(std::is_nothrow_move_constructible_v<SmallArray<int, 4>>);
+		static_assert(std::is_nothrow_move_constructible_v<SmallArray<std::string, 4>>);
+		static_assert(std::is_nothrow_move_assignable_v<SmallArray<int, 4>>);
+		static_assert(std::is_nothrow_move_assignable_v<SmallArray<std::string, 4>>);
+		// polymorphic_allocator doesn't propagate - arrays of different resources move elements into new memory
+		static_assert(!std::is_nothrow_move_assignable_v<SmallArray<int, 4, std::pmr::polymorphic_allocator<int>>>);
+	}
+}
+
+TEST_CASE("SmallArray vs Array for small sizes", "[.benchmark]")
+{
+	constexpr size_t count = 100'000;
+
+	auto heap_calls_of = [](auto create) {
+		const size_t before = global_heap_calls;
+		for (size_t i = 0; i < count; ++i)
+			create(1 + i % 16);
+		return global_heap_calls - before;
+	};
+
+	std::cout << "heap calls for " << count << " arrays of 1-16 ints:\n"
+		<< "  Array<int>: " << heap_calls_of([](size_t size) { return Array<int>(size, 1).size(); }) << "\n"
+		<< "  SmallArray<int, 16>: " << heap_calls_of([](size_t size) { return SmallArray<int, 16>(size, 1).size(); }) << "\n";
+
+	BENCHMARK("Array<int>")
+	{
+		size_t sum = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			Array<int> arr(1 + i % 16, 1);
+			sum += arr[arr.size() - 1];
+		}
+		return sum;
+	};
+
+	BENCHMARK("SmallArray<int, 16>")
+	{
+		size_t sum = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			SmallArray<int, 16> arr(1 + i % 16, 1);
+			sum += arr[arr.size() - 1];
+		}
+		return sum;
+	};
+}
+
+namespace
+{
+	struct Tracked
+	{
+		static inline size_t default_constructions = 0;
+		static inline size_t copies = 0;
+
+		int value = -1;
+
+		Tracked() { ++default_constructions; }
+
+		Tracked(const Tracked& other) : value(other.value) { ++copies; }
+
+		Tracked& operator=(const Tracked&) = default;
+
+		static void reset_counters()
+		{
+			default_constructions = copies = 0;
+		}
+	};
+}
+
+TEST_CASE("Array construction modes")
+{
+	Tracked::reset_counters();
+
+	SECTION("fill copies the value once into every element")
+	{
+		Array<Tracked> arr(5, Tracked{});
+
+		REQUIRE(Tracked::default_constructions == 1);
+		REQUIRE(Tracked::copies == 5);
+	}
+
+	SECTION("default_init calls only default constructors")
+	{
+		Array<Tracked> arr(5, default_init);
+
+		REQUIRE(Tracked::default_constructions == 5);
+		REQUIRE(Tracked::copies == 0);
+
+		Array<std::string> strings(3, default_init);
+		REQUIRE(strings == Array<std::string>(3));
+	}
+
+	SECTION("uninitialized storage is written by the caller")
+	{
+		Array<int> arr(1'000, uninitialized);
+		std::iota(arr.begin(), arr.end(), 0);
+
+		REQUIRE(arr.size() == 1'000);
+		REQUIRE(arr[665] == 665);
+	}
+
+	SECTION("all modes work with memory resources")
+	{
+		std::pmr::monotonic_buffer_resource arena;
+
+		PmrArray<int> arr1(10, uninitialized, &arena);
+		PmrArray<std::pmr::string> arr2(2, default_init, &arena);
+
+		REQUIRE(arr1.get_allocator().resource() == &arena);
+		REQUIRE(arr2[1].get_allocator().resource() == &arena);
+	}
+}
+
+TEST_CASE("Array construction modes - 100M elements", "[.benchmark]")
+{
+	constexpr size_t size = 100'000'000;
+
+	BENCHMARK("fill + iota")
+	{
+		Array<int> arr(size, 0);
+		std::iota(arr.begin(), arr.end(), 0);
+		return arr[size / 2];
+	};
+
+	BENCHMARK("default_init + iota")
+	{
+		Array<int> arr(size, default_init);
+		std::iota(arr.begin(), arr.end(), 0);
+		return arr[size / 2];
+	};
+
+	BENCHMARK("uninitialized + iota")
+	{
+		Array<int> arr(size, uninitialized);
+		std::iota(arr.begin(), arr.end(), 0);
+		return arr[size / 2];
+	};
+}
+
+TEST_CASE("Array instrumentation")
+{
+	using Counters = Instrumentation::Counters<Array<int>>;
+	Counters::reset();
+
+	{
+		Array<int> a(10, 1);
+		Array<int> b = a;
+		Array<int> c = std::move(a);
+		b = c;
+		c = std::move(b);
+
+		// self-assignment copies nothing, so it isn't counted
+		Array<int>& same_c = c;
+		c = same_c;
+		c = std::move(same_c);
+	}
+
+	const auto counts = Counters::get();
+
+	if constexpr (Counters::enabled)
+	{
+		REQUIRE(counts.constructions == 3);
+		REQUIRE(counts.copies == 2);
+		REQUIRE(counts.moves == 2);
+		REQUIRE(counts.bytes_allocated == 3 * 10 * sizeof(int));
+	}
+	else
+	{
+		REQUIRE(counts.constructions == 0);
+		REQUIRE(counts.bytes_allocated == 0);
+	}
+}
+
+TEST_CASE("Array copies and moves", "[.benchmark]")
+{
+	const Array<int> source(16, 1);
+
+	BENCHMARK("copy + move of Array<int>(16)")
+	{
+		Array<int> copy = source;
+		Array<int> target = std::move(copy);
+		return target[15];
+	};
+
+	const auto counts = Instrumentation::Counters<Array<int>>::get();
+	std::cout << "Array<int> - copies: " << counts.copies << ", moves: " << counts.moves
+		<< ", bytes allocated: " << counts.bytes_allocated << "\n";
+}
+
+TEST_CASE("Array growth")
+{
+	SECTION("push_back grows capacity geometrically")
+	{
+		Array<int> arr;
+		std::vector<size_t> capacities;
+
+		for (int i = 0; i < 100; ++i)
+		{
+			arr.push_back(i);
+			if (capacities.empty() || capacities.back() != arr.capacity())
+				capacities.push_back(arr.capacity());
+		}
+
+		REQUIRE(arr.size() == 100);
+		REQUIRE(arr[99] == 99);
+		REQUIRE(capacities == std::vector<size_t>{ 1, 2, 4, 8, 16, 32, 64, 128 });
+	}
+
+	SECTION("push_back of an element of the same array")
+	{
+		Array<std::string> words = { "one" };
+		for (int i = 0; i < 10; ++i)
+			words.push_back(words[0]);
+
+		REQUIRE(std::count(words.begin(), words.end(), "one") == 11);
+	}
+
+	SECTION("reserve keeps elements")
+	{
+		Array<std::string> words = { "one", "two" };
+		words.reserve(100);
+
+		REQUIRE(words.capacity() == 100);
+		REQUIRE(words == Array<std::string>{ "one", "two" });
+	}
+
+	SECTION("resize")
+	{
+		Array<int> arr = { 1, 2, 3 };
+
+		arr.resize(5);
+		REQUIRE(arr == Array<int>{ 1, 2, 3, 0, 0 });
+
+		arr.resize(2);
+		REQUIRE(arr == Array<int>{ 1, 2 });
+
+		arr.resize(4, arr[1]);
+		REQUIRE(arr == Array<int>{ 1, 2, 2, 2 });
+	}
+
+	SECTION("nested arrays are relocated without copies")
+	{
+		using Counters = Instrumentation::Counters<Array<int>>;
+
+		Array<Array<int>> rows;
+		rows.push_back(Array<int>(10, 1));
+		const int* first_row = rows[0].begin();
+
+		Counters::reset();
+		for (int i = 0; i < 100; ++i)
+			rows.push_back(Array<int>(10, i));
+
+		REQUIRE(rows[0].begin() == first_row);
+		REQUIRE(Counters::get().copies == 0);
+	}
+
+	SECTION("growth works with memory resources")
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		PmrArray<std::pmr::string> words(&arena);
+
+		for (int i = 0; i < 20; ++i)
+			words.emplace_back("a string too long for the small string optimization");
+
+		REQUIRE(words.size() == 20);
+		REQUIRE(words[19].get_allocator().resource() == &arena);
+	}
+}
+
+TEST_CASE("Array move operations are noexcept")
+{
+	static_assert(std::is_nothrow_move_constructible_v<Array<int>>);
+	static_assert(std::is_nothrow_move_assignable_v<Array<int>>);
+	static_assert(std::is_nothrow_move_constructible_v<PmrArray<int>>);
+	static_assert(is_trivially_relocatable_v<Array<Array<RGB<uint32_t>>>>);
+	static_assert(!is_trivially_relocatable_v<std::string>);
+
+	SECTION("std::vector moves arrays when it reallocates")
+	{
+		using Counters = Instrumentation::Counters<Array<int>>;
+		Counters::reset();
+
+		std::vector<Array<int>> vec;
+		for (int i = 0; i < 100; ++i)
+			vec.push_back(Array<int>(10, i));
+
+		REQUIRE(vec[99][9] == 99);
+		REQUIRE(Counters::get().copies == 0);
+	}
+}
+
+TEST_CASE("nested Array<Array<RGB<uint32_t>>> vs std::vector", "[.benchmark]")
+{
+	constexpr size_t height = 1'000;
+	constexpr size_t width = 1'000;
+	const RGB<uint32_t> pixel{ 128, 0, 255 };
+
+	BENCHMARK("std::vector<std::vector<RGB>> - push_back")
+	{
+		std::vector<std::vector<RGB<uint32_t>>> image;
+		for (size_t y = 0; y < height; ++y)
+		{
+			std::vector<RGB<uint32_t>> row;
+			for (size_t x = 0; x < width; ++x)
+				row.push_back(pixel);
+			image.push_back(std::move(row));
+		}
+		return image[height / 2][width / 2].b;
+	};
+
+	BENCHMARK("Array<Array<RGB>> - push_back")
+	{
+		Array<Array<RGB<uint32_t>>> image;
+		for (size_t y = 0; y < height; ++y)
+		{
+			Array<RGB<uint32_t>> row;
+			for (size_t x = 0; x < width; ++x)
+				row.push_back(pixel);
+			image.push_back(std::move(row));
+		}
+		return image[height / 2][width / 2].b;
+	};
+
+	BENCHMARK("Array<Array<RGB>> - reserve + push_back")
+	{
+		Array<Array<RGB<uint32_t>>> image;
+		image.reserve(height);
+		for (size_t y = 0; y < height; ++y)
+		{
+			Array<RGB<uint32_t>> row;
+			row.reserve(width);
+			for (size_t x = 0; x < width; ++x)
+				row.push_back(pixel);
+			image.push_back(std::move(row));
+		}
+		return image[height / 2][width / 2].b;
+	};
+
+	BENCHMARK("Array<Array<RGB>> - fill constructor")
+	{
+		Array<Array<RGB<uint32_t>>> image(height, Array<RGB<uint32_t>>(width, pixel));
+		return image[height / 2][width / 2].b;
+	};
+}